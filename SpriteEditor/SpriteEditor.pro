@@ -1,6 +1,6 @@
 QT       += core gui
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 
 CONFIG += c++17
 
@@ -9,17 +9,50 @@ CONFIG += c++17
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    autosavejournal.cpp \
+    blend.cpp \
+    brush.cpp \
+    canvaslayer.cpp \
     displays.cpp \
+    floodfill.cpp \
+    framedelegate.cpp \
+    framelistmodel.cpp \
+    framepager.cpp \
+    legacyprojectfile.cpp \
     main.cpp \
     mainwindow.cpp \
     models.cpp \
-    palette.cpp
+    palette.cpp \
+    projectfile.cpp \
+    projectio.cpp \
+    stroketracker.cpp \
+    thumbnailservice.cpp \
+    tiledframe.cpp \
+    transforms.cpp
 
 HEADERS += \
+    autosavejournal.h \
+    blend.h \
+    brush.h \
+    canvaslayer.h \
+    contenthash.h \
     displays.h \
+    floodfill.h \
+    framedelegate.h \
+    framelistmodel.h \
+    framepager.h \
+    legacyprojectfile.h \
     mainwindow.h \
     models.h \
-    palette.h
+    palette.h \
+    pixelview.h \
+    projectfile.h \
+    projectio.h \
+    rasterizer.h \
+    stroketracker.h \
+    thumbnailservice.h \
+    tiledframe.h \
+    transforms.h
 
 FORMS += \
     mainwindow.ui
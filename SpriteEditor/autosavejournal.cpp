@@ -0,0 +1,327 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the autosave journal.
+ */
+
+#include "autosavejournal.h"
+#include "legacyprojectfile.h"
+#include "pixelview.h"
+#include "projectfile.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QtEndian>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+    const char MAGIC[4] = {'S', 'S', 'P', 'J'};
+
+    /**
+     * Appends a little-endian integer to a byte array
+     */
+    template <typename T>
+    void append(QByteArray &out, T value)
+    {
+        T little = qToLittleEndian(value);
+        out.append(reinterpret_cast<const char *>(&little), sizeof(T));
+    }
+
+    /**
+     * Reads a little-endian integer at a byte offset, the caller checks the bounds
+     */
+    template <typename T>
+    T readAt(const uchar *data, qint64 offset)
+    {
+        return qFromLittleEndian<T>(data + offset);
+    }
+
+    /**
+     * A transparent frame of the canvas size, used for frames the journal never wrote
+     */
+    QImage blankFrame(int size)
+    {
+        QImage frame(size, size, QImage::Format_ARGB32);
+        frame.fill(0);
+        return frame;
+    }
+}
+
+QString AutosaveJournal::path() const
+{
+    return filePath;
+}
+
+qint64 AutosaveJournal::size() const
+{
+    return fileSize;
+}
+
+void AutosaveJournal::reset(const QString &newPath, int canvasSize, const QString &baseProject,
+                            const std::vector<quint32> &baseIds)
+{
+    if (!filePath.isEmpty() && filePath != newPath)
+        remove();
+    filePath = newPath;
+    replacing = true;
+
+    QByteArray base = baseProject.toUtf8();
+    pending.clear();
+    pending.append(MAGIC, sizeof(MAGIC));
+    append<quint16>(pending, VERSION);
+    append<quint16>(pending, 0);
+    append<quint32>(pending, quint32(canvasSize));
+    append<quint32>(pending, quint32(base.size()));
+    pending.append(base);
+    addIds(Record::BASE, baseIds);
+}
+
+void AutosaveJournal::addRecord(Record type, const QByteArray &payload)
+{
+    append<quint8>(pending, quint8(type));
+    pending.append(3, '\0');
+    append<quint32>(pending, quint32(payload.size()));
+    pending.append(payload);
+}
+
+void AutosaveJournal::addIds(Record type, const std::vector<quint32> &ids)
+{
+    QByteArray payload;
+    payload.reserve(qsizetype(ids.size() + 1) * 4);
+    append<quint32>(payload, quint32(ids.size()));
+    for (quint32 id : ids)
+        append<quint32>(payload, id);
+    addRecord(type, payload);
+}
+
+void AutosaveJournal::addLayout(const std::vector<quint32> &ids)
+{
+    addIds(Record::LAYOUT, ids);
+}
+
+void AutosaveJournal::addFrame(quint32 id, const QImage &frame, const QRect &rect)
+{
+    Q_ASSERT(frame.rect().contains(rect));
+
+    // Gather the rectangle's rows into one array so a small change encodes only its own pixels
+    ConstPixelView pixels(frame);
+    rectPixels.resize(size_t(rect.width()) * rect.height());
+    for (int y = 0; y < rect.height(); y++)
+    {
+        std::memcpy(rectPixels.data() + size_t(y) * rect.width(), pixels.row(rect.top() + y) + rect.left(),
+                    size_t(rect.width()) * sizeof(QRgb));
+    }
+    ProjectFile::encodeRuns(rectPixels.data(), qsizetype(rectPixels.size()), encoded);
+
+    QByteArray payload;
+    payload.reserve(20 + encoded.size());
+    append<quint32>(payload, id);
+    append<quint32>(payload, quint32(rect.x()));
+    append<quint32>(payload, quint32(rect.y()));
+    append<quint32>(payload, quint32(rect.width()));
+    append<quint32>(payload, quint32(rect.height()));
+    payload.append(encoded);
+    addRecord(Record::FRAME, payload);
+}
+
+bool AutosaveJournal::commit(QString &error)
+{
+    QByteArray bytes;
+    bytes.swap(pending);
+    if (filePath.isEmpty())
+    {
+        error = "No autosave file was chosen.";
+        return false;
+    }
+
+    if (replacing)
+    {
+        // A new journal replaces the old one only once it is complete
+        QSaveFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size() || !file.commit())
+        {
+            error = file.errorString();
+            return false;
+        }
+        replacing = false;
+        fileSize = bytes.size();
+        return true;
+    }
+
+    if (bytes.isEmpty())
+    {
+        return true;
+    }
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append) || file.write(bytes) != bytes.size() || !file.flush())
+    {
+        error = file.errorString();
+        return false;
+    }
+    fileSize = file.size();
+    return true;
+}
+
+void AutosaveJournal::remove()
+{
+    if (!filePath.isEmpty())
+        QFile::remove(filePath);
+    fileSize = 0;
+}
+
+bool AutosaveJournal::hasEdits(const QString &journalPath)
+{
+    QFile file(journalPath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    QByteArray header = file.read(HEADER_SIZE);
+    if (header.size() < HEADER_SIZE || !header.startsWith(QByteArray(MAGIC, sizeof(MAGIC))))
+    {
+        return false;
+    }
+
+    // Skip the base path and the BASE record, anything after them is an edit
+    const uchar *data = reinterpret_cast<const uchar *>(header.constData());
+    qint64 offset = HEADER_SIZE + readAt<quint32>(data, 12);
+    if (!file.seek(offset))
+    {
+        return false;
+    }
+    QByteArray record = file.read(RECORD_HEADER_SIZE);
+    if (record.size() < RECORD_HEADER_SIZE)
+    {
+        return false;
+    }
+    offset += RECORD_HEADER_SIZE + readAt<quint32>(reinterpret_cast<const uchar *>(record.constData()), 4);
+    return file.size() > offset;
+}
+
+bool AutosaveJournal::replay(const QString &journalPath, Recovery &recovery, QString &error)
+{
+    QFile file(journalPath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        error = "Unable to open the autosave file.";
+        return false;
+    }
+    QByteArray bytes = file.readAll();
+    const uchar *data = reinterpret_cast<const uchar *>(bytes.constData());
+    const qint64 length = bytes.size();
+
+    const QString formatError = "The autosave file is damaged.";
+    if (length < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || readAt<quint16>(data, 4) != VERSION)
+    {
+        error = formatError;
+        return false;
+    }
+    quint32 size = readAt<quint32>(data, 8);
+    quint32 baseLength = readAt<quint32>(data, 12);
+    if (size == 0 || size > quint32(ProjectFile::MAX_SIZE) || baseLength > quint64(length - HEADER_SIZE))
+    {
+        error = formatError;
+        return false;
+    }
+    QString baseProject = QString::fromUtf8(bytes.constData() + HEADER_SIZE, baseLength);
+
+    // Start from the base project, a new canvas starts from blank frames
+    std::vector<QImage> base;
+    if (!baseProject.isEmpty())
+    {
+        int baseSize = 0;
+        QString baseError;
+        bool read = ProjectFile::isBinary(baseProject)
+                        ? ProjectFile::read(baseProject, base, baseSize, baseError)
+                        : LegacyProjectFile::read(baseProject, base, baseSize, baseError);
+        if (!read || baseSize != int(size))
+        {
+            error = "The project the autosave was made from could not be read.\n" + baseError;
+            return false;
+        }
+    }
+
+    std::unordered_map<quint32, QImage> images;
+    std::vector<quint32> layout;
+    std::vector<QRgb> rectPixels;
+    qint64 offset = HEADER_SIZE + baseLength;
+    while (length - offset >= RECORD_HEADER_SIZE)
+    {
+        Record type = Record(data[offset]);
+        quint32 payloadSize = readAt<quint32>(data, offset + 4);
+        offset += RECORD_HEADER_SIZE;
+        // A record cut short was being written when the editor stopped
+        if (payloadSize > quint64(length - offset))
+            break;
+        const uchar *payload = data + offset;
+        offset += payloadSize;
+
+        if (type == Record::BASE || type == Record::LAYOUT)
+        {
+            quint32 count = payloadSize >= 4 ? readAt<quint32>(payload, 0) : 0;
+            if (payloadSize < 4 || count > (payloadSize - 4) / 4)
+            {
+                error = formatError;
+                return false;
+            }
+            layout.resize(count);
+            for (quint32 i = 0; i < count; i++)
+            {
+                layout[i] = readAt<quint32>(payload, 4 + qint64(i) * 4);
+                if (type == Record::BASE && i < base.size())
+                    images[layout[i]] = std::move(base[i]);
+            }
+        }
+        else if (type == Record::FRAME)
+        {
+            if (payloadSize < 20)
+            {
+                error = formatError;
+                return false;
+            }
+            quint32 id = readAt<quint32>(payload, 0);
+            quint32 x = readAt<quint32>(payload, 4);
+            quint32 y = readAt<quint32>(payload, 8);
+            quint32 width = readAt<quint32>(payload, 12);
+            quint32 height = readAt<quint32>(payload, 16);
+            if (x > size || y > size || width > size - x || height > size - y)
+            {
+                error = formatError;
+                return false;
+            }
+            rectPixels.resize(size_t(width) * height);
+            if (!ProjectFile::decodeRuns(payload + 20, payloadSize - 20, rectPixels.data(), qsizetype(rectPixels.size())))
+            {
+                error = formatError;
+                return false;
+            }
+
+            auto found = images.find(id);
+            if (found == images.end())
+                found = images.emplace(id, blankFrame(int(size))).first;
+            PixelView pixels(found->second);
+            for (quint32 row = 0; row < height; row++)
+            {
+                std::memcpy(pixels.row(int(y + row)) + x, rectPixels.data() + size_t(row) * width, size_t(width) * sizeof(QRgb));
+            }
+        }
+    }
+
+    if (layout.empty())
+    {
+        error = formatError;
+        return false;
+    }
+
+    recovery.frames.clear();
+    recovery.frames.reserve(layout.size());
+    for (quint32 id : layout)
+    {
+        auto found = images.find(id);
+        recovery.frames.push_back(found != images.end() ? found->second : blankFrame(int(size)));
+    }
+    recovery.baseProject = baseProject;
+    return true;
+}
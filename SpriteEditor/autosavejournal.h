@@ -0,0 +1,135 @@
+#ifndef AUTOSAVEJOURNAL_H
+#define AUTOSAVEJOURNAL_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QRect>
+#include <QString>
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief An append-only log of the edits made since a project was last saved or loaded, used to recover work after a
+ * crash. The journal names a base project file, or none for a new blank canvas, and records the changed rectangles
+ * of frames and the frame order. Frames are identified by ids that stay the same when frames are moved, so
+ * reordering only writes a new order. Records are gathered in memory and written together by commit.
+ *
+ * Layout, all integers little-endian:
+ *   header: "SSPJ", quint16 version, quint16 reserved, quint32 canvas size, quint32 base path bytes, UTF-8 base path
+ *   record: quint8 type, 3 reserved bytes, quint32 payload size, payload
+ *     BASE:   quint32 count, count frame ids given to the base project's frames in file order
+ *     FRAME:  quint32 id, quint32 x, y, width, height, the rectangle's pixels run-length encoded as in ProjectFile
+ *     LAYOUT: quint32 count, count frame ids in animation order
+ */
+class AutosaveJournal
+{
+public:
+    /**
+     * @brief What replaying a journal produced
+     */
+    struct Recovery
+    {
+        // The frames in animation order
+        std::vector<QImage> frames;
+        // The base project the edits were made to, empty for a new canvas
+        QString baseProject;
+    };
+
+    /**
+     * @brief path - the journal file, empty until reset names one
+     */
+    QString path() const;
+
+    /**
+     * @brief size - bytes the journal file holds after the last commit
+     */
+    qint64 size() const;
+
+    /**
+     * @brief reset - starts a new journal, the next commit replaces the file instead of appending to it
+     * A different previous journal file is deleted right away, its edits were saved or abandoned
+     * @param filePath - the journal file
+     * @param canvasSize - width and height of every frame
+     * @param baseProject - the project file the edits apply to, empty for a blank canvas
+     * @param baseIds - the ids of the base project's frames in file order
+     */
+    void reset(const QString &filePath, int canvasSize, const QString &baseProject, const std::vector<quint32> &baseIds);
+
+    /**
+     * @brief addFrame - records the pixels of one rectangle of a frame
+     * @param id - the frame's id
+     * @param frame - the frame, ARGB32
+     * @param rect - the changed area, inside the frame
+     */
+    void addFrame(quint32 id, const QImage &frame, const QRect &rect);
+
+    /**
+     * @brief addLayout - records the order of the frames
+     * @param ids - the frame ids in animation order
+     */
+    void addLayout(const std::vector<quint32> &ids);
+
+    /**
+     * @brief commit - writes the gathered records, appending them or atomically replacing the file after a reset
+     * @param error - set to a description of the problem when writing fails
+     * @return true if the records are on disk, false otherwise, the records are dropped either way
+     */
+    bool commit(QString &error);
+
+    /**
+     * @brief remove - deletes the journal file, for when its edits no longer need recovering
+     */
+    void remove();
+
+    /**
+     * @brief hasEdits - checks whether a journal file records any edits to recover
+     * @param filePath - the journal file
+     */
+    static bool hasEdits(const QString &filePath);
+
+    /**
+     * @brief replay - rebuilds the frames a journal describes, loading its base project first
+     * A record cut short by a crash ends the journal, everything before it is recovered
+     * @param filePath - the journal file
+     * @param recovery - filled with the recovered frames
+     * @param error - set to a description of the problem when recovery fails
+     * @return true if the frames were recovered
+     */
+    static bool replay(const QString &filePath, Recovery &recovery, QString &error);
+
+private:
+    static constexpr quint16 VERSION = 1;
+    static constexpr int HEADER_SIZE = 16;
+    static constexpr int RECORD_HEADER_SIZE = 8;
+
+    enum class Record : quint8
+    {
+        BASE = 1,
+        FRAME = 2,
+        LAYOUT = 3
+    };
+
+    /**
+     * @brief addRecord - appends a record header and payload to the pending bytes
+     */
+    void addRecord(Record type, const QByteArray &payload);
+
+    /**
+     * @brief addIds - appends a BASE or LAYOUT record
+     */
+    void addIds(Record type, const std::vector<quint32> &ids);
+
+    QString filePath;
+    // Header and records not written yet
+    QByteArray pending;
+    // True when the next commit replaces the file
+    bool replacing = false;
+    qint64 fileSize = 0;
+    // Reused for the pixels and runs of each FRAME record
+    std::vector<QRgb> rectPixels;
+    QByteArray encoded;
+};
+
+#endif // AUTOSAVEJOURNAL_H
@@ -0,0 +1,274 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the blend kernels. The vector kernels work on float lanes: every product in the formula
+ * stays below 2^24 so floats hold it exactly, and each integer division is a float division followed by a one step
+ * correction, which makes the result match the integer formula bit for bit
+ */
+
+#include "blend.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLEND_HAVE_SSE2
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define BLEND_TARGET_AVX2
+#else
+#define BLEND_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+QRgb Blend::pixel(QRgb src, QRgb dst)
+{
+    // A fully transparent black pixel simply takes the new color
+    if (dst == 0)
+        return src;
+
+    int redDest = qRed(dst), greenDest = qGreen(dst), blueDest = qBlue(dst), alphaDest = qAlpha(dst);
+    int redSrc = qRed(src), greenSrc = qGreen(src), blueSrc = qBlue(src), alphaSrc = qAlpha(src);
+
+    // Compute the new alpha value using an additive blend formula
+    int alphaOverride = alphaSrc + alphaDest * (255 - alphaSrc) / 255;
+    if (alphaOverride == 0)
+        return 0; // Fully transparent if resulting alpha is zero
+
+    // Compute new RGB values based on the relative contribution of each color
+    int redOverride = (redSrc * alphaSrc + redDest * alphaDest * (255 - alphaSrc) / 255) / alphaOverride;
+    int greenOverride = (greenSrc * alphaSrc + greenDest * alphaDest * (255 - alphaSrc) / 255) / alphaOverride;
+    int blueOverride = (blueSrc * alphaSrc + blueDest * alphaDest * (255 - alphaSrc) / 255) / alphaOverride;
+
+    // Results out of range never reached the canvas, so the pixel keeps its color
+    if (redOverride > 255 || greenOverride > 255 || blueOverride > 255)
+        return dst;
+
+    return qRgba(redOverride, greenOverride, blueOverride, alphaOverride);
+}
+
+namespace
+{
+    /**
+     * Blends one pixel at a time. Used on CPUs without SSE2 and for the tail of every span
+     */
+    template <bool Solid>
+    void blendScalar(QRgb *dst, const QRgb *src, int count)
+    {
+        for (int i = 0; i < count; i++)
+            dst[i] = Blend::pixel(Solid ? *src : src[i], dst[i]);
+    }
+
+#ifdef BLEND_HAVE_SSE2
+    /**
+     * Exact floor(x / 255) for whole numbers below 2^24 held in float lanes
+     */
+    inline __m128 div255Sse2(__m128 x)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 k255 = _mm_set1_ps(255.0f);
+        __m128 q = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.0f / 255.0f))));
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, k255));
+        q = _mm_add_ps(q, _mm_and_ps(_mm_cmpge_ps(r, k255), one));
+        return _mm_sub_ps(q, _mm_and_ps(_mm_cmplt_ps(r, _mm_setzero_ps()), one));
+    }
+
+    /**
+     * Exact floor(n / d) for whole numbers below 2^24 held in float lanes, d must not be 0
+     */
+    inline __m128 divSse2(__m128 n, __m128 d)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        __m128 q = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(n, d)));
+        __m128 r = _mm_sub_ps(n, _mm_mul_ps(q, d));
+        q = _mm_add_ps(q, _mm_and_ps(_mm_cmpge_ps(r, d), one));
+        return _mm_sub_ps(q, _mm_and_ps(_mm_cmplt_ps(r, _mm_setzero_ps()), one));
+    }
+
+    /**
+     * Blends four pixels
+     */
+    inline __m128i blendSse2(__m128i s, __m128i d)
+    {
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+        const __m128 k255 = _mm_set1_ps(255.0f);
+
+        __m128 alphaSrc = _mm_cvtepi32_ps(_mm_srli_epi32(s, 24));
+        __m128 alphaDest = _mm_cvtepi32_ps(_mm_srli_epi32(d, 24));
+
+        // alphaDest * (255 - alphaSrc) is shared by the alpha and every color channel
+        __m128 destWeight = _mm_mul_ps(alphaDest, _mm_sub_ps(k255, alphaSrc));
+        __m128 alpha = _mm_add_ps(alphaSrc, div255Sse2(destWeight));
+        __m128 divisor = _mm_max_ps(alpha, _mm_set1_ps(1.0f));
+
+        __m128i result = _mm_slli_epi32(_mm_cvttps_epi32(alpha), 24);
+        __m128 overflow = _mm_setzero_ps();
+        for (int shift = 0; shift <= 16; shift += 8)
+        {
+            __m128 channelSrc = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(s, shift), byteMask));
+            __m128 channelDest = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d, shift), byteMask));
+            __m128 numerator = _mm_add_ps(_mm_mul_ps(channelSrc, alphaSrc), div255Sse2(_mm_mul_ps(channelDest, destWeight)));
+            __m128 channel = divSse2(numerator, divisor);
+            overflow = _mm_or_ps(overflow, _mm_cmpgt_ps(channel, k255));
+            result = _mm_or_si128(result, _mm_slli_epi32(_mm_cvttps_epi32(channel), shift));
+        }
+
+        // Out of range results keep the destination, empty destinations take the source
+        __m128i keepDest = _mm_castps_si128(overflow);
+        result = _mm_or_si128(_mm_and_si128(keepDest, d), _mm_andnot_si128(keepDest, result));
+        __m128i takeSrc = _mm_cmpeq_epi32(d, _mm_setzero_si128());
+        return _mm_or_si128(_mm_and_si128(takeSrc, s), _mm_andnot_si128(takeSrc, result));
+    }
+
+    template <bool Solid>
+    void spanSse2(QRgb *dst, const QRgb *src, int count)
+    {
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i s = Solid ? _mm_set1_epi32(int(*src)) : _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), blendSse2(s, d));
+        }
+        blendScalar<Solid>(dst + i, Solid ? src : src + i, count - i);
+    }
+
+    BLEND_TARGET_AVX2 inline __m256 div255Avx2(__m256 x)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 k255 = _mm256_set1_ps(255.0f);
+        __m256 q = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.0f / 255.0f))));
+        __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(q, k255));
+        q = _mm256_add_ps(q, _mm256_and_ps(_mm256_cmp_ps(r, k255, _CMP_GE_OQ), one));
+        return _mm256_sub_ps(q, _mm256_and_ps(_mm256_cmp_ps(r, _mm256_setzero_ps(), _CMP_LT_OQ), one));
+    }
+
+    BLEND_TARGET_AVX2 inline __m256 divAvx2(__m256 n, __m256 d)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        __m256 q = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_div_ps(n, d)));
+        __m256 r = _mm256_sub_ps(n, _mm256_mul_ps(q, d));
+        q = _mm256_add_ps(q, _mm256_and_ps(_mm256_cmp_ps(r, d, _CMP_GE_OQ), one));
+        return _mm256_sub_ps(q, _mm256_and_ps(_mm256_cmp_ps(r, _mm256_setzero_ps(), _CMP_LT_OQ), one));
+    }
+
+    /**
+     * Blends eight pixels, the same steps as blendSse2
+     */
+    BLEND_TARGET_AVX2 inline __m256i blendAvx2(__m256i s, __m256i d)
+    {
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        const __m256 k255 = _mm256_set1_ps(255.0f);
+
+        __m256 alphaSrc = _mm256_cvtepi32_ps(_mm256_srli_epi32(s, 24));
+        __m256 alphaDest = _mm256_cvtepi32_ps(_mm256_srli_epi32(d, 24));
+
+        __m256 destWeight = _mm256_mul_ps(alphaDest, _mm256_sub_ps(k255, alphaSrc));
+        __m256 alpha = _mm256_add_ps(alphaSrc, div255Avx2(destWeight));
+        __m256 divisor = _mm256_max_ps(alpha, _mm256_set1_ps(1.0f));
+
+        __m256i result = _mm256_slli_epi32(_mm256_cvttps_epi32(alpha), 24);
+        __m256 overflow = _mm256_setzero_ps();
+        for (int shift = 0; shift <= 16; shift += 8)
+        {
+            __m256 channelSrc = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(s, shift), byteMask));
+            __m256 channelDest = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(d, shift), byteMask));
+            __m256 numerator = _mm256_add_ps(_mm256_mul_ps(channelSrc, alphaSrc), div255Avx2(_mm256_mul_ps(channelDest, destWeight)));
+            __m256 channel = divAvx2(numerator, divisor);
+            overflow = _mm256_or_ps(overflow, _mm256_cmp_ps(channel, k255, _CMP_GT_OQ));
+            result = _mm256_or_si256(result, _mm256_slli_epi32(_mm256_cvttps_epi32(channel), shift));
+        }
+
+        result = _mm256_blendv_epi8(result, d, _mm256_castps_si256(overflow));
+        return _mm256_blendv_epi8(result, s, _mm256_cmpeq_epi32(d, _mm256_setzero_si256()));
+    }
+
+    template <bool Solid>
+    BLEND_TARGET_AVX2 void spanAvx2(QRgb *dst, const QRgb *src, int count)
+    {
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i s = Solid ? _mm256_set1_epi32(int(*src)) : _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), blendAvx2(s, d));
+        }
+        spanSse2<Solid>(dst + i, Solid ? src : src + i, count - i);
+    }
+
+    /**
+     * Checks once whether the CPU and OS support AVX2
+     */
+    bool cpuHasAvx2()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuid(info, 1);
+        bool avxEnabled = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        return avxEnabled && (info[1] & (1 << 5));
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    using SpanKernel = void (*)(QRgb *, const QRgb *, int);
+
+    /**
+     * Picks the fastest kernel the CPU supports
+     */
+    template <bool Solid>
+    SpanKernel selectKernel()
+    {
+#ifdef BLEND_HAVE_SSE2
+        return cpuHasAvx2() ? spanAvx2<Solid> : spanSse2<Solid>;
+#else
+        return blendScalar<Solid>;
+#endif
+    }
+}
+
+void Blend::span(QRgb *dst, const QRgb *src, int count)
+{
+    static const SpanKernel kernel = selectKernel<false>();
+    kernel(dst, src, count);
+}
+
+void Blend::solidSpan(QRgb *dst, QRgb color, int count)
+{
+    static const SpanKernel kernel = selectKernel<true>();
+    kernel(dst, &color, count);
+}
+
+bool Blend::isSupported(Path path)
+{
+#ifdef BLEND_HAVE_SSE2
+    static const bool hasAvx2 = cpuHasAvx2();
+    return path != Path::AVX2 || hasAvx2;
+#else
+    return path == Path::SCALAR;
+#endif
+}
+
+void Blend::span(Path path, QRgb *dst, const QRgb *src, int count)
+{
+    Q_ASSERT(isSupported(path));
+    switch (path)
+    {
+#ifdef BLEND_HAVE_SSE2
+    case Path::AVX2:
+        spanAvx2<false>(dst, src, count);
+        return;
+    case Path::SSE2:
+        spanSse2<false>(dst, src, count);
+        return;
+#endif
+    default:
+        blendScalar<false>(dst, src, count);
+        return;
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef BLEND_H
+#define BLEND_H
+
+#include <QRgb>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Source-over blending of ARGB32 pixels used by every tool that paints over existing pixels.
+ * Spans are blended with AVX2 or SSE2 kernels when the CPU has them and with a scalar loop otherwise.
+ * Every path gives exactly the same result as the editor's original integer formula
+ */
+class Blend
+{
+public:
+    /**
+     * @brief The kernels a span can be blended with
+     */
+    enum class Path
+    {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * @brief pixel - blends one source pixel over one destination pixel
+     * A fully transparent black destination takes the source as is. If the formula puts a color channel above 255 the
+     * destination is left unchanged, which is what happened when the result went through an invalid QColor
+     * @param src - the color being painted
+     * @param dst - the color already on the canvas
+     * @return the blended color
+     */
+    static QRgb pixel(QRgb src, QRgb dst);
+
+    /**
+     * @brief span - blends a run of source pixels over a run of destination pixels in place
+     * @param dst - the pixels already on the canvas, overwritten with the result
+     * @param src - the pixels being painted
+     * @param count - the number of pixels in both runs
+     */
+    static void span(QRgb *dst, const QRgb *src, int count);
+
+    /**
+     * @brief solidSpan - blends one color over a run of destination pixels in place
+     * @param dst - the pixels already on the canvas, overwritten with the result
+     * @param color - the color being painted
+     * @param count - the number of pixels in the run
+     */
+    static void solidSpan(QRgb *dst, QRgb color, int count);
+
+    /**
+     * @brief isSupported - returns true if the build and the CPU can run a kernel
+     * @param path - the kernel
+     */
+    static bool isSupported(Path path);
+
+    /**
+     * @brief span - blends a run of pixels with a chosen kernel instead of the fastest one, so every kernel can be
+     * checked against the scalar formula
+     * @param path - the kernel, it must be supported
+     * @param dst - the pixels already on the canvas, overwritten with the result
+     * @param src - the pixels being painted
+     * @param count - the number of pixels in both runs
+     */
+    static void span(Path path, QRgb *dst, const QRgb *src, int count);
+};
+
+#endif // BLEND_H
@@ -0,0 +1,187 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the brush stamp masks.
+ */
+
+#include "brush.h"
+#include "pixelview.h"
+#include <QtGlobal>
+
+namespace
+{
+    // 4x4 Bayer matrix, entries below the threshold of a dither pattern are painted
+    const int BAYER[4][4] = {
+        {0, 8, 2, 10},
+        {12, 4, 14, 6},
+        {3, 11, 1, 9},
+        {15, 7, 13, 5}};
+}
+
+Brush::Brush()
+{
+    rebuild();
+}
+
+void Brush::setSize(int newSize)
+{
+    newSize = qBound(MIN_SIZE, newSize, MAX_SIZE);
+    if (newSize == size)
+    {
+        return;
+    }
+    size = newSize;
+    rebuild();
+}
+
+void Brush::setShape(Shape newShape)
+{
+    if (newShape == shape)
+    {
+        return;
+    }
+    shape = newShape;
+    rebuild();
+}
+
+void Brush::setDither(Dither newDither)
+{
+    if (newDither == dither)
+    {
+        return;
+    }
+    dither = newDither;
+    rebuild();
+}
+
+void Brush::setCustomStamp(const QImage &stamp)
+{
+    customStamp = stamp.isNull() ? QImage() : stamp.convertToFormat(QImage::Format_ARGB32);
+    if (shape == Shape::CUSTOM)
+    {
+        rebuild();
+    }
+}
+
+int Brush::getSize() const
+{
+    return size;
+}
+
+const Brush::Mask &Brush::mask(int x, int y) const
+{
+    if (dithered.empty())
+    {
+        return solid;
+    }
+    return dithered[(y & (DITHER_SIZE - 1)) * DITHER_SIZE + (x & (DITHER_SIZE - 1))];
+}
+
+const Brush::Mask &Brush::solidMask() const
+{
+    return solid;
+}
+
+void Brush::rebuild()
+{
+    coverage.assign(size * size, false);
+
+    if (shape == Shape::CIRCLE)
+    {
+        // Pixel centres inside a circle of diameter size, in doubled coordinates to stay in integers
+        for (int j = 0; j < size; j++)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                int dx = 2 * i - (size - 1);
+                int dy = 2 * j - (size - 1);
+                coverage[j * size + i] = dx * dx + dy * dy <= size * size;
+            }
+        }
+    }
+    else if (shape == Shape::CUSTOM && !customStamp.isNull())
+    {
+        QImage scaled = customStamp.scaled(size, size, Qt::KeepAspectRatio, Qt::FastTransformation);
+        ConstPixelView stamp(scaled);
+        int offsetX = (size - stamp.width()) / 2;
+        int offsetY = (size - stamp.height()) / 2;
+        for (int y = 0; y < stamp.height(); y++)
+        {
+            const QRgb *row = stamp.row(y);
+            for (int x = 0; x < stamp.width(); x++)
+            {
+                coverage[(y + offsetY) * size + x + offsetX] = qAlpha(row[x]) > 0;
+            }
+        }
+    }
+    else
+    {
+        coverage.assign(size * size, true);
+    }
+
+    solid = buildMask(0, 0, DITHER_SIZE * DITHER_SIZE);
+
+    dithered.clear();
+    int threshold = 0;
+    switch (dither)
+    {
+    case Dither::DENSE:
+        threshold = 12;
+        break;
+    case Dither::HALF:
+        threshold = 8;
+        break;
+    case Dither::SPARSE:
+        threshold = 4;
+        break;
+    default:
+        return;
+    }
+
+    dithered.reserve(DITHER_SIZE * DITHER_SIZE);
+    for (int phaseY = 0; phaseY < DITHER_SIZE; phaseY++)
+    {
+        for (int phaseX = 0; phaseX < DITHER_SIZE; phaseX++)
+        {
+            dithered.push_back(buildMask(phaseX, phaseY, threshold));
+        }
+    }
+}
+
+Brush::Mask Brush::buildMask(int phaseX, int phaseY, int threshold) const
+{
+    Mask result;
+
+    // The cursor pixel is the stamp centre, rounded towards the top left for even sizes
+    int origin = (size - 1) / 2;
+    for (int j = 0; j < size; j++)
+    {
+        int dy = j - origin;
+        int i = 0;
+        while (i < size)
+        {
+            // A stamp pixel is kept when it is covered and the dither cell at its canvas position allows it
+            auto kept = [&](int column)
+            {
+                int dx = column - origin;
+                return coverage[j * size + column] &&
+                       BAYER[(phaseY + dy) & (DITHER_SIZE - 1)][(phaseX + dx) & (DITHER_SIZE - 1)] < threshold;
+            };
+
+            if (!kept(i))
+            {
+                i++;
+                continue;
+            }
+            int start = i;
+            while (i < size && kept(i))
+            {
+                i++;
+            }
+            result.runs.push_back({dy, start - origin, i - start});
+            result.bounds |= QRect(start - origin, dy, i - start, 1);
+        }
+    }
+    return result;
+}
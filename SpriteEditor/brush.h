@@ -0,0 +1,135 @@
+#ifndef BRUSH_H
+#define BRUSH_H
+
+#include <QImage>
+#include <QRect>
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief The brush used by the brush and eraser tools. The stamp for the current size, shape and dither pattern is
+ * computed once into run-length masks, so applying it is a handful of span writes per row
+ */
+class Brush
+{
+public:
+    static constexpr int MIN_SIZE = 1;
+    static constexpr int MAX_SIZE = 64;
+
+    /**
+     * @brief The outline of the stamp
+     */
+    enum class Shape
+    {
+        SQUARE,
+        CIRCLE,
+        CUSTOM
+    };
+
+    /**
+     * @brief Ordered dither patterns, named by the share of stamp pixels they paint
+     */
+    enum class Dither
+    {
+        SOLID,
+        DENSE,
+        HALF,
+        SPARSE
+    };
+
+    /**
+     * @brief A horizontal run of stamp pixels, relative to the pixel under the cursor
+     */
+    struct Run
+    {
+        int dy;
+        int dx;
+        int length;
+    };
+
+    /**
+     * @brief A stamp as row-ordered runs, with the area they cover relative to the pixel under the cursor
+     */
+    struct Mask
+    {
+        std::vector<Run> runs;
+        QRect bounds;
+    };
+
+    /**
+     * @brief Brush - creates a one pixel solid square brush
+     */
+    Brush();
+
+    /**
+     * @brief setSize - sets the width and height of the stamp, clamped to MIN_SIZE..MAX_SIZE
+     */
+    void setSize(int size);
+
+    /**
+     * @brief setShape - sets the stamp outline, CUSTOM uses the image given to setCustomStamp
+     */
+    void setShape(Shape shape);
+
+    /**
+     * @brief setDither - sets the dither pattern, which is anchored to the canvas so overlapping stamps line up
+     */
+    void setDither(Dither dither);
+
+    /**
+     * @brief setCustomStamp - sets the image the CUSTOM shape is made from
+     * Pixels with any alpha are part of the stamp; the image is scaled to the brush size keeping its aspect ratio
+     * @param stamp - the stamp image, a null image falls back to the square shape
+     */
+    void setCustomStamp(const QImage &stamp);
+
+    /**
+     * @brief getSize - returns the width and height of the stamp
+     */
+    int getSize() const;
+
+    /**
+     * @brief mask - returns the dithered stamp to apply with the cursor over the given canvas pixel
+     * @param x - x coordinate of the canvas pixel under the cursor
+     * @param y - y coordinate of the canvas pixel under the cursor
+     */
+    const Mask &mask(int x, int y) const;
+
+    /**
+     * @brief solidMask - returns the stamp without dithering, as used by the eraser
+     */
+    const Mask &solidMask() const;
+
+private:
+    // Side of the ordered dither matrix, masks are built for every phase of it
+    static constexpr int DITHER_SIZE = 4;
+
+    /**
+     * @brief rebuild - recomputes the stamp coverage and every mask after a setting changed
+     */
+    void rebuild();
+
+    /**
+     * @brief buildMask - run-length encodes the covered stamp pixels that the dither pattern keeps
+     * @param phaseX - canvas x coordinate of the cursor modulo DITHER_SIZE
+     * @param phaseY - canvas y coordinate of the cursor modulo DITHER_SIZE
+     * @param threshold - dither matrix entries below this are painted, DITHER_SIZE squared paints every pixel
+     */
+    Mask buildMask(int phaseX, int phaseY, int threshold) const;
+
+    int size = MIN_SIZE;
+    Shape shape = Shape::SQUARE;
+    Dither dither = Dither::SOLID;
+    QImage customStamp;
+
+    // Row-major size x size coverage of the undithered stamp
+    std::vector<bool> coverage;
+
+    // The undithered stamp, and one mask per dither phase when dithering
+    Mask solid;
+    std::vector<Mask> dithered;
+};
+
+#endif // BRUSH_H
@@ -0,0 +1,52 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of a canvas layer. Holds a pixmap of an image and patches only the dirty rect into it
+ */
+
+#include "canvaslayer.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+CanvasLayer::CanvasLayer(QGraphicsItem *parent) : QGraphicsItem(parent)
+{
+    // Lets paint() see the exposed rect so only that part is drawn
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+void CanvasLayer::refresh(const QImage &image, const QRect &dirty)
+{
+    QRect area = dirty;
+    if (pixmap.size() != image.size())
+    {
+        // A new canvas size needs a new pixmap, so upload everything
+        prepareGeometryChange();
+        pixmap = QPixmap(image.size());
+        pixmap.fill(Qt::transparent); // Gives the pixmap an alpha channel
+        area = image.rect();
+    }
+    area &= image.rect();
+    if (area.isEmpty())
+        return;
+
+    // Replace the pixels in the dirty area instead of blending over them
+    QPainter painter(&pixmap);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(area.topLeft(), image, area);
+    painter.end();
+
+    update(area);
+}
+
+QRectF CanvasLayer::boundingRect() const
+{
+    return QRectF(QPointF(0, 0), pixmap.size());
+}
+
+void CanvasLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+    QRectF exposed = option->exposedRect & boundingRect();
+    painter->drawPixmap(exposed, pixmap, exposed);
+}
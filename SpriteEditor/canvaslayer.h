@@ -0,0 +1,52 @@
+#ifndef CANVASLAYER_H
+#define CANVASLAYER_H
+
+#include <QGraphicsItem>
+#include <QPixmap>
+#include <QImage>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief A scene item that keeps a pixmap copy of one of the model's images and only re-uploads the parts that change
+ */
+class CanvasLayer : public QGraphicsItem
+{
+public:
+    /**
+     * @brief CanvasLayer - creates an empty layer
+     * @param parent - the parent item in the scene, if any
+     */
+    explicit CanvasLayer(QGraphicsItem *parent = nullptr);
+
+    /**
+     * @brief refresh - copies the dirty part of the image into the layer and repaints only that area
+     * The whole image is uploaded if its size no longer matches the layer
+     * @param image - the image this layer displays
+     * @param dirty - the area of the image that changed
+     */
+    void refresh(const QImage &image, const QRect &dirty);
+
+    /**
+     * @brief boundingRect - the area covered by the layer in scene coordinates
+     * @return the rect of the uploaded image
+     */
+    QRectF boundingRect() const override;
+
+    /**
+     * @brief paint - draws the exposed part of the layer
+     * @param painter - the painter for the view
+     * @param option - describes the exposed area
+     * @param widget - the widget being painted on
+     */
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+    /**
+     * @brief pixmap - the uploaded copy of the image
+     */
+    QPixmap pixmap;
+};
+
+#endif // CANVASLAYER_H
@@ -0,0 +1,111 @@
+#ifndef CONTENTHASH_H
+#define CONTENTHASH_H
+
+#include <QRgb>
+#include <QtGlobal>
+#include <cstring>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief A fast 64-bit hash of pixel data in the style of xxHash64. Four independent lanes each take one 64-bit word
+ * of every 32 byte block, so the compiler can keep them in registers or vectorize them, and the lanes are folded
+ * together and mixed at the end. Equal pixels always hash the same, different pixels almost never do, but callers
+ * that must be certain compare the pixels when hashes match
+ */
+class ContentHash
+{
+public:
+    /**
+     * @brief pixels - hashes a run of pixels
+     * @param pixels - the pixels to hash
+     * @param count - number of pixels
+     * @param seed - starts the hash, hashes made with different seeds are unrelated
+     */
+    static quint64 pixels(const QRgb *pixels, qsizetype count, quint64 seed = 0)
+    {
+        const uchar *data = reinterpret_cast<const uchar *>(pixels);
+        const qsizetype length = count * qsizetype(sizeof(QRgb));
+        const uchar *end = data + length;
+        quint64 hash;
+
+        if (length >= 32)
+        {
+            quint64 lanes[4] = {seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1};
+            const uchar *blockEnd = end - 32;
+            do
+            {
+                for (int lane = 0; lane < 4; lane++)
+                    lanes[lane] = round(lanes[lane], read64(data + lane * 8));
+                data += 32;
+            } while (data <= blockEnd);
+
+            hash = rotate(lanes[0], 1) + rotate(lanes[1], 7) + rotate(lanes[2], 12) + rotate(lanes[3], 18);
+            for (quint64 lane : lanes)
+                hash = (hash ^ round(0, lane)) * PRIME1 + PRIME4;
+        }
+        else
+        {
+            hash = seed + PRIME5;
+        }
+        hash += quint64(length);
+
+        // Whole pixels are left over in 8 and 4 byte pieces
+        for (; data + 8 <= end; data += 8)
+            hash = rotate(hash ^ round(0, read64(data)), 27) * PRIME1 + PRIME4;
+        if (data < end)
+        {
+            quint32 word;
+            std::memcpy(&word, data, sizeof(word));
+            hash = rotate(hash ^ (quint64(word) * PRIME1), 23) * PRIME2 + PRIME3;
+        }
+        return avalanche(hash);
+    }
+
+    /**
+     * @brief combine - folds one more value into a hash, the order of values matters
+     * @param hash - the hash so far
+     * @param value - the value to add, usually another hash
+     */
+    static quint64 combine(quint64 hash, quint64 value)
+    {
+        return avalanche(rotate(hash ^ round(0, value), 27) * PRIME1 + PRIME4);
+    }
+
+private:
+    static constexpr quint64 PRIME1 = 0x9E3779B185EBCA87ULL;
+    static constexpr quint64 PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr quint64 PRIME3 = 0x165667B19E3779F9ULL;
+    static constexpr quint64 PRIME4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr quint64 PRIME5 = 0x27D4EB2F165667C5ULL;
+
+    static quint64 rotate(quint64 value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static quint64 read64(const uchar *data)
+    {
+        quint64 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static quint64 round(quint64 accumulator, quint64 input)
+    {
+        return rotate(accumulator + input * PRIME2, 31) * PRIME1;
+    }
+
+    static quint64 avalanche(quint64 hash)
+    {
+        hash ^= hash >> 33;
+        hash *= PRIME2;
+        hash ^= hash >> 29;
+        hash *= PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+};
+
+#endif // CONTENTHASH_H
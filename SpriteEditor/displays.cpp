@@ -7,6 +7,10 @@
  */
 
 #include "displays.h"
+#include "framedelegate.h"
+#include <QAction>
+#include <QInputDialog>
+#include <algorithm>
 
 Displays::Displays(Ui::MainWindow *ui, Model *model, QWidget *parent)
     : QWidget(parent), ui(ui), model(model)
@@ -30,22 +34,27 @@ Displays::Displays(Ui::MainWindow *ui, Model *model, QWidget *parent)
             &QPushButton::clicked,
             model,
             &Model::clearCanvas);
-    connect(model,
-            &Model::canvasUpdated,
-            this,
-            &Displays::onCanvasUpdated);
 }
 
 void Displays::initializeFrameSelector()
 {
-    // Set the box to hold all frame buttons
-    framesLayout = new QVBoxLayout();
-    framesLayout->setAlignment(Qt::AlignTop | Qt::AlignCenter);
-    framesLayout->setContentsMargins(0, 20, 0, 20);
-
-    ui->frameSelectorScrollContent->setLayout(framesLayout);
-    ui->frameSelector->setWidget(ui->frameSelectorScrollContent);
-    ui->frameSelector->setWidgetResizable(true);
+    // The list only paints the rows in view, every row has the same size so none has to be measured
+    frameList = new FrameListModel(model, this);
+    ui->frameSelector->setModel(frameList);
+    ui->frameSelector->setItemDelegate(new FrameDelegate(this));
+    ui->frameSelector->setUniformItemSizes(true);
+    ui->frameSelector->setSelectionMode(QAbstractItemView::ContiguousSelection);
+
+    // Rows can be dragged to a new place in the selector
+    ui->frameSelector->setDragDropMode(QAbstractItemView::DragDrop);
+    ui->frameSelector->setDefaultDropAction(Qt::MoveAction);
+    ui->frameSelector->setDragDropOverwriteMode(false);
+    ui->frameSelector->setDropIndicatorShown(true);
+
+    connect(ui->frameSelector,
+            &QListView::clicked,
+            this,
+            &Displays::frameClicked);
 
     // Set the style for all frame selector buttons
     ui->addFrameButton->setStyleSheet(getButtonStyle());
@@ -76,156 +85,111 @@ void Displays::initializeFrameSelector()
             this,
             &Displays::shiftFrameDownClicked);
 
-    createFrameButton(0);
-    updateFrameButtonStyle();
+    initializeRangeActions();
+    setSelectedFrameIndex(model->getCurrentFrameIndex());
 }
 
-void Displays::createFrameButton(int index)
+void Displays::initializeRangeActions()
 {
-    QPushButton *frameButton = new QPushButton(ui->frameSelectorScrollContent);
-    frameButton->setProperty("frameIndex", index);
-
-    // Set icon and connection for frame button
-    updateFrameButtonIcon(frameButton);
-    connect(frameButton, &QPushButton::clicked, this, &Displays::frameButtonClicked);
+    // Shift-clicking a frame selects a range, right-clicking the selector works on the whole range
+    QAction *duplicateAction = new QAction("Duplicate Frames", ui->frameSelector);
+    QAction *deleteAction = new QAction("Delete Frames", ui->frameSelector);
+    QAction *reverseAction = new QAction("Reverse Frames", ui->frameSelector);
+    QAction *insertBlankAction = new QAction("Insert Blank Frames...", ui->frameSelector);
+    QAction *pingPongAction = new QAction("Add Ping-Pong Loop", ui->frameSelector);
+
+    connect(duplicateAction,
+            &QAction::triggered,
+            this,
+            &Displays::duplicateFrameButtonClicked);
+    connect(deleteAction,
+            &QAction::triggered,
+            this,
+            &Displays::deleteFrameButtonClicked);
+    connect(reverseAction,
+            &QAction::triggered,
+            this,
+            &Displays::reverseSelectedFrames);
+    connect(insertBlankAction,
+            &QAction::triggered,
+            this,
+            &Displays::insertBlankFramesClicked);
+    connect(pingPongAction,
+            &QAction::triggered,
+            this,
+            &Displays::addPingPongFrames);
 
-    framesLayout->insertWidget(index, frameButton);
-    frameButtons.insert(index, frameButton);
+    ui->frameSelector->setContextMenuPolicy(Qt::ActionsContextMenu);
+    ui->frameSelector->addActions({duplicateAction, deleteAction, reverseAction, insertBlankAction, pingPongAction});
 }
 
-QPushButton *Displays::updateFrameButtonIcon(QPushButton *button)
+std::pair<int, int> Displays::selectedRange() const
 {
-    int index = button->property("frameIndex").toInt();
-    QPixmap thumbnail = model->getFrameThumbnail(index, 110, 110);
-
-    button->setIcon(QIcon(thumbnail));
-    button->setIconSize(thumbnail.size());
-    button->setFixedSize(112, 112);
-
-    return button;
+    // The selection is contiguous, without one the range is the current frame alone
+    QModelIndexList rows = ui->frameSelector->selectionModel()->selectedIndexes();
+    if (rows.isEmpty())
+        return {int(model->getCurrentFrameIndex()), 1};
+    auto [low, high] = std::minmax_element(rows.begin(), rows.end(), [](const QModelIndex &a, const QModelIndex &b)
+                                           { return a.row() < b.row(); });
+    return {low->row(), high->row() - low->row() + 1};
 }
 
-void Displays::updateFrameButtonStyle()
+void Displays::frameClicked(const QModelIndex &index)
 {
-    // Sets the currently selected frame as a blue border, rest back to default
-    for (int i = 0; i < frameButtons.size(); i++)
-    {
-        if (i == selectedFrameIndex)
-            frameButtons[i]->setStyleSheet("QPushButton { border: 2px solid blue; border-radius: 4px}");
-        else
-            frameButtons[i]->setStyleSheet("");
-    }
-}
-
-void Displays::frameButtonClicked()
-{
-    QPushButton *button = qobject_cast<QPushButton *>(sender());
-    if (!button)
-        return;
-
-    int index = button->property("frameIndex").toInt();
-
-    // Selects the frame that was pressed and updates its border/icon
-    model->selectFrame(index);
-    updateFrameButtonStyle();
-    updateFrameButtonIcon(button);
+    // Selects the frame that was clicked, the view keeps the shift-clicked range itself
+    model->selectFrame(index.row());
 }
 
 void Displays::addFrameButtonClicked()
 {
+    // The row is added by the frame list once the model inserted the frame
     model->addFrame();
-    int newIndex = model->getCurrentFrameIndex();
-    createFrameButton(newIndex);
-
-    // Reassign properties for following frameButtons
-    for (int i = newIndex + 1; i < frameButtons.size(); i++)
-    {
-        frameButtons[i]->setProperty("frameIndex", i);
-        updateFrameButtonIcon(frameButtons[i]);
-    }
-
-    selectedFrameIndex = newIndex;
-    updateFrameButtonStyle();
 }
 
 void Displays::duplicateFrameButtonClicked()
 {
-    model->duplicateFrame();
-    int newIndex = model->getCurrentFrameIndex();
-    createFrameButton(newIndex);
-
-    for (int i = newIndex + 1; i < frameButtons.size(); i++)
-    {
-        frameButtons[i]->setProperty("frameIndex", i);
-        updateFrameButtonIcon(frameButtons[i]);
-    }
-
-    selectedFrameIndex = newIndex;
-    updateFrameButtonStyle();
+    auto [first, count] = selectedRange();
+    model->duplicateFrames(first, count);
 }
 
 void Displays::deleteFrameButtonClicked()
 {
-    QPushButton *buttonToRemove = frameButtons[selectedFrameIndex];
-
-    // If there is only one frame, clear it instead
-    if (model->getFrames().size() <= 1)
-    {
-        model->removeFrame(selectedFrameIndex);
-        updateFrameButtonIcon(buttonToRemove);
-        return;
-    }
+    // Removing every frame keeps one and clears it, its icon follows the canvas update
+    auto [first, count] = selectedRange();
+    model->removeFrames(first, count);
+}
 
-    // Delete the frame from model and display
-    model->removeFrame(selectedFrameIndex);
-    framesLayout->removeWidget(buttonToRemove);
-    buttonToRemove->deleteLater();
-    frameButtons.remove(selectedFrameIndex);
+void Displays::reverseSelectedFrames()
+{
+    auto [first, count] = selectedRange();
+    model->reverseFrames(first, count);
+}
 
-    // Reassign properties for following frameButtons
-    for (int i = selectedFrameIndex; i < frameButtons.size(); i++)
-    {
-        frameButtons[i]->setProperty("frameIndex", i);
-        updateFrameButtonIcon(frameButtons[i]);
-    }
+void Displays::insertBlankFramesClicked()
+{
+    bool ok;
+    int count = QInputDialog::getInt(ui->frameSelector, "Insert Blank Frames", "Number of blank frames:", 1, 1, 1000, 1, &ok);
+    if (!ok)
+        return;
+    auto [first, selected] = selectedRange();
+    model->insertBlankFrames(first + selected, count);
+}
 
-    selectedFrameIndex = model->getCurrentFrameIndex();
-    updateFrameButtonStyle();
+void Displays::addPingPongFrames()
+{
+    auto [first, count] = selectedRange();
+    model->addPingPongFrames(first, count);
 }
 
 void Displays::shiftFrameUpClicked()
 {
-    if (selectedFrameIndex <= 0)
-        return;
-
+    // The first frame stays where it is, the model ignores moves past either end
     model->shiftFrameUp();
-    selectedFrameIndex = model->getCurrentFrameIndex();
-    updateFrameButtonIcon(frameButtons[selectedFrameIndex + 1]);
-    updateFrameButtonIcon(frameButtons[selectedFrameIndex]);
-
-    updateFrameButtonStyle();
 }
 
 void Displays::shiftFrameDownClicked()
 {
-    if (selectedFrameIndex >= frameButtons.size() - 1)
-        return;
-
     model->shiftFrameDown();
-    selectedFrameIndex = model->getCurrentFrameIndex();
-    updateFrameButtonIcon(frameButtons[selectedFrameIndex - 1]);
-    updateFrameButtonIcon(frameButtons[selectedFrameIndex]);
-
-    updateFrameButtonStyle();
-}
-
-void Displays::onCanvasUpdated()
-{
-    // Updates the icon in the frame selector to match canvas changes
-    if (selectedFrameIndex >= 0 && selectedFrameIndex < frameButtons.size())
-    {
-        updateFrameButtonIcon(frameButtons[selectedFrameIndex]);
-    }
 }
 
 void Displays::initializeAnimationControls()
@@ -260,6 +224,17 @@ void Displays::initializeAnimationControls()
         "border: 2px solid #555;"
         "border-radius: 4px"));
 
+    // Playing an animation that does not change only looks its previews up
+    previews = new ThumbnailService(PREVIEW_SIZE, this);
+    connect(previews,
+            &ThumbnailService::thumbnailReady,
+            this,
+            &Displays::animationPreviewReady);
+    connect(model,
+            &Model::framesReloaded,
+            previews,
+            &ThumbnailService::clear);
+
     connect(ui->animationFpsSlider,
             &QSlider::valueChanged,
             model,
@@ -270,25 +245,6 @@ void Displays::initializeAnimationControls()
             &Model::toggleAnimation);
 }
 
-void Displays::rebuildFrameButtonsFromModel()
-{
-    // Deletes every frame from the display
-    while (!frameButtons.isEmpty())
-    {
-        QPushButton *button = frameButtons.takeLast();
-        framesLayout->removeWidget(button);
-        button->deleteLater();
-    }
-
-    // Adds the frames from the model
-    int frameCount = model->getFrames().size();
-    for (int i = 0; i < frameCount; ++i)
-        createFrameButton(i);
-
-    selectedFrameIndex = 0;
-    updateFrameButtonStyle();
-}
-
 void Displays::updateFpsText(int value)
 {
     ui->animationFpsSliderIO->setText(QString("FPS: %1").arg(value));
@@ -306,8 +262,51 @@ void Displays::toggleAnimationPlayPauseIcon(bool enabled)
 
 void Displays::drawAnimationIcon(int index)
 {
-    QPixmap newImage = model->getFrameThumbnail(index, 220, 220);
-    ui->animationDisplayLabel->setPixmap(newImage);
+    QPixmap preview;
+    previewId = model->getFrameId(index);
+    quint64 generation = model->getFrameGeneration(index);
+    if (!previews->find(previewId, generation, preview))
+    {
+        // An outdated preview still shows the right frame until the new one is ready. Without any, the label would
+        // keep showing the frame before, so the preview is made right away
+        if (preview.isNull())
+            preview = previews->make(previewId, generation, model->getFrameSnapshot(index));
+        else
+            previews->request(previewId, generation, model->getFrameSnapshot(index));
+    }
+    showAnimationPreview(preview);
+
+    // The frames coming up are scaled in the background while this one shows, so playback seldom has to wait for a
+    // preview to be made
+    int count = int(model->getFrameCount());
+    for (int ahead = 1; ahead <= PREVIEW_AHEAD && ahead < count; ahead++)
+        requestAnimationPreview((index + ahead) % count);
+}
+
+void Displays::requestAnimationPreview(int index)
+{
+    QPixmap preview;
+    quint32 id = model->getFrameId(index);
+    quint64 generation = model->getFrameGeneration(index);
+    if (!previews->find(id, generation, preview))
+        previews->request(id, generation, model->getFrameSnapshot(index));
+}
+
+void Displays::animationPreviewReady(quint32 id)
+{
+    if (id != previewId)
+        return;
+    QPixmap preview;
+    previews->find(id, 0, preview);
+    showAnimationPreview(preview);
+}
+
+void Displays::showAnimationPreview(const QPixmap &preview)
+{
+    // Setting the pixmap the label already shows would repaint it for nothing
+    if (preview.isNull() || preview.cacheKey() == ui->animationDisplayLabel->pixmap().cacheKey())
+        return;
+    ui->animationDisplayLabel->setPixmap(preview);
 }
 
 QString Displays::getButtonStyle()
@@ -322,5 +321,10 @@ QString Displays::getButtonStyle()
 
 void Displays::setSelectedFrameIndex(unsigned int index)
 {
-    selectedFrameIndex = index;
+    // A frame the model selected replaces the selected range, a row the user clicked is already current
+    QModelIndex row = frameList->index(int(index));
+    if (row == ui->frameSelector->currentIndex())
+        return;
+    ui->frameSelector->selectionModel()->setCurrentIndex(row, QItemSelectionModel::ClearAndSelect);
+    ui->frameSelector->scrollTo(row);
 }
@@ -3,11 +3,10 @@
 #define DISPLAYS_H
 
 #include <QWidget>
-#include <QScrollArea>
-#include <QVBoxLayout>
 #include <QPushButton>
-#include <QVector>
+#include "framelistmodel.h"
 #include "models.h"
+#include "thumbnailservice.h"
 #include "ui_mainwindow.h"
 
 /**
@@ -29,10 +28,6 @@ public:
      */
     explicit Displays(Ui::MainWindow *ui, Model *model, QWidget *parent = nullptr);
 
-    /**
-     * Clears the frames to empty and then adds all of the frames back from the model
-     */
-    void rebuildFrameButtonsFromModel();
 
 public slots:
     /**
@@ -42,17 +37,19 @@ public slots:
     void addFrameButtonClicked();
 
     /**
-     * Sets the selected frame index to the passed value
+     * Makes the frame at the passed index the current row of the frame selector, the selected range shrinks to it
      * @param index The index to set the selected frame index to
      */
     void setSelectedFrameIndex(unsigned int index);
 
+
 private slots:
     /**
      * A handler for when one of the frames is clicked
      * Selects the clicked frame
+     * @param index The clicked row
      */
-    void frameButtonClicked();
+    void frameClicked(const QModelIndex &index);
 
     /**
      * A handler for when the delete frame button is clicked
@@ -67,6 +64,21 @@ private slots:
      */
     void duplicateFrameButtonClicked();
 
+    /**
+     * Reverses the order of the selected frames
+     */
+    void reverseSelectedFrames();
+
+    /**
+     * Asks how many blank frames to add and inserts them after the selected frames
+     */
+    void insertBlankFramesClicked();
+
+    /**
+     * Adds copies of the selected frames in reverse order after them so they play forwards and back
+     */
+    void addPingPongFrames();
+
     /**
      * A handler for when the shift frame up button is clicked
      * Moves the currently selected frame up one position
@@ -95,14 +107,17 @@ private slots:
 
     /**
      * Draws the animation for the frame at the given index
+     * Previews are scaled once for every edit of a frame, in the background ahead of playback and while an outdated
+     * one of the same frame can be shown. Only a frame that has none at all is scaled right away
      * @param index The index for the frame to display
      */
     void drawAnimationIcon(int index);
 
     /**
-     * Tells the class the canvas has been updated and to subsequently update the frames
+     * Shows a preview that was just made if the animation is still on its frame
+     * @param id The id of the frame the preview shows
      */
-    void onCanvasUpdated();
+    void animationPreviewReady(quint32 id);
 
 private:
     /**
@@ -122,47 +137,62 @@ private:
     QString getButtonStyle();
 
     /**
-     * The layout to display all of the frames
+     * The frames as rows of the frame selector
      */
-    QVBoxLayout *framesLayout = nullptr;
+    FrameListModel *frameList = nullptr;
 
     /**
-     * A vector to hold all of the current frames as QPushButtons
+     * Gives the selected range of frames, the view only allows contiguous selections
+     * @return The index of the first selected frame and the number of selected frames
      */
-    QVector<QPushButton *> frameButtons;
+    std::pair<int, int> selectedRange() const;
 
     /**
-     * The index of the currently selected frame
+     * Initializes the frame selector to its default state
      */
-    int selectedFrameIndex = 0;
+    void initializeFrameSelector();
 
     /**
-     * Initializes the frame selector to its default state
+     * Adds the right-click menu of the frame selector with the operations on the selected range
      */
-    void initializeFrameSelector();
+    void initializeRangeActions();
 
     /**
-     * Creates a new frame at the given index
-     * @param index The index of the new frame
+     * Initializes all animation preview controls
      */
-    void createFrameButton(int index);
+    void initializeAnimationControls();
 
     /**
-     * Updates the frame buton to have the most up to date image of the canvas
-     * @param button The button for the frame to update
-     * @return The button with the updated icon
+     * Width and height of the animation preview
      */
-    QPushButton *updateFrameButtonIcon(QPushButton *button);
+    static constexpr int PREVIEW_SIZE = 220;
 
     /**
-     * Updates all frames to have the correct border for styling
+     * How many frames past the one shown have their previews made in the background
      */
-    void updateFrameButtonStyle();
+    static constexpr int PREVIEW_AHEAD = 3;
 
     /**
-     * Initializes all animation preview controls
+     * Frames scaled to the animation preview, by frame id and edit generation
      */
-    void initializeAnimationControls();
+    ThumbnailService *previews = nullptr;
+
+    /**
+     * The id of the frame the animation preview shows
+     */
+    quint32 previewId = 0;
+
+    /**
+     * Starts making the preview of a frame in the background, unless an up to date one is cached
+     * @param index The index of the frame
+     */
+    void requestAnimationPreview(int index);
+
+    /**
+     * Puts a preview on the animation display, unless it already shows it
+     * @param preview The preview to show
+     */
+    void showAnimationPreview(const QPixmap &preview);
 };
 
 #endif // DISPLAYS_H
@@ -0,0 +1,166 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the scanline flood fill. Spans are grown left and right on one row, then the rows above and below are scanned for new seeds, so the work stays on an explicit stack instead of the call stack
+ */
+
+#include "floodfill.h"
+#include "pixelview.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    /**
+     * A pixel where a new span may start
+     */
+    struct Seed
+    {
+        int x;
+        int y;
+        // The span on the row this seed was found from, which is already filled and never needs rescanning
+        int parentY;
+        int parentLeft;
+        int parentRight;
+    };
+}
+
+bool FloodFill::matches(QRgb pixel, QRgb target, int tolerance)
+{
+    if (pixel == target)
+        return true;
+    if (tolerance <= 0)
+        return false;
+
+    // Compare every channel against the tolerance
+    return std::abs(qRed(pixel) - qRed(target)) <= tolerance &&
+           std::abs(qGreen(pixel) - qGreen(target)) <= tolerance &&
+           std::abs(qBlue(pixel) - qBlue(target)) <= tolerance &&
+           std::abs(qAlpha(pixel) - qAlpha(target)) <= tolerance;
+}
+
+QRect FloodFill::fill(QImage &image, int x, int y, QRgb fillColor, const Options &options)
+{
+    if (image.format() != QImage::Format_ARGB32 || !image.rect().contains(x, y))
+        return QRect();
+
+    const int width = image.width();
+    const int height = image.height();
+    const QRgb target = ConstPixelView(image).at(x, y);
+    const int tolerance = options.tolerance;
+
+    // Filling a region with its own color changes nothing
+    if (tolerance <= 0 && target == fillColor)
+        return QRect();
+
+    if (options.global)
+        return fillGlobal(image, target, fillColor, tolerance);
+
+    // Filled pixels normally stop matching, but a fill color inside the tolerance would keep matching and loop forever.
+    // Only in that case is one bit per pixel kept to mark what is already filled
+    const bool trackVisited = matches(fillColor, target, tolerance);
+    std::vector<quint64> visited(trackVisited ? (size_t(width) * height + 63) / 64 : 0, 0);
+    auto isOpen = [&](const QRgb *row, int px, int py)
+    {
+        // Exact matches are checked inline since they are by far the common case
+        if (row[px] != target && (tolerance <= 0 || !matches(row[px], target, tolerance)))
+            return false;
+        if (!trackVisited)
+            return true;
+        size_t bit = size_t(py) * width + px;
+        return ((visited[bit >> 6] >> (bit & 63)) & 1) == 0;
+    };
+
+    // Diagonal neighbours are reached by scanning one pixel past each end of a span
+    const int reach = options.connectivity == Connectivity::EIGHT ? 1 : 0;
+
+    PixelView pixels(image);
+    int minX = x, maxX = x, minY = y, maxY = y;
+    std::vector<Seed> stack;
+    stack.push_back({x, y, -1, 0, -1});
+
+    while (!stack.empty())
+    {
+        Seed seed = stack.back();
+        stack.pop_back();
+
+        QRgb *row = pixels.row(seed.y);
+        if (!isOpen(row, seed.x, seed.y))
+            continue;
+
+        // Grow the span left and right from the seed
+        int left = seed.x;
+        while (left > 0 && isOpen(row, left - 1, seed.y))
+            left--;
+        int right = seed.x;
+        while (right < width - 1 && isOpen(row, right + 1, seed.y))
+            right++;
+
+        // Write the whole span at once
+        std::fill(row + left, row + right + 1, fillColor);
+        if (trackVisited)
+        {
+            for (size_t bit = size_t(seed.y) * width + left; bit <= size_t(seed.y) * width + right; bit++)
+                visited[bit >> 6] |= quint64(1) << (bit & 63);
+        }
+
+        minX = std::min(minX, left);
+        maxX = std::max(maxX, right);
+        minY = std::min(minY, seed.y);
+        maxY = std::max(maxY, seed.y);
+
+        // Queue one seed for every run of matching pixels in the rows above and below
+        for (int nextY : {seed.y - 1, seed.y + 1})
+        {
+            if (nextY < 0 || nextY >= height)
+                continue;
+
+            const QRgb *nextRow = pixels.row(nextY);
+            bool towardParent = nextY == seed.parentY;
+            int scanEnd = std::min(width - 1, right + reach);
+            bool inRun = false;
+            for (int i = std::max(0, left - reach); i <= scanEnd; i++)
+            {
+                // Jump over the parent span since it was filled before this one
+                if (towardParent && i >= seed.parentLeft && i <= seed.parentRight)
+                {
+                    i = seed.parentRight;
+                    inRun = false;
+                    continue;
+                }
+                bool candidate = isOpen(nextRow, i, nextY);
+                if (candidate && !inRun)
+                    stack.push_back({i, nextY, seed.y, left, right});
+                inRun = candidate;
+            }
+        }
+    }
+
+    return QRect(QPoint(minX, minY), QPoint(maxX, maxY));
+}
+
+QRect FloodFill::fillGlobal(QImage &image, QRgb target, QRgb fillColor, int tolerance)
+{
+    PixelView pixels(image);
+    QRect filled;
+    for (int y = 0; y < pixels.height(); y++)
+    {
+        QRgb *row = pixels.row(y);
+        int first = -1, last = -1;
+        for (int x = 0; x < pixels.width(); x++)
+        {
+            if (row[x] != fillColor && matches(row[x], target, tolerance))
+            {
+                row[x] = fillColor;
+                if (first < 0)
+                    first = x;
+                last = x;
+            }
+        }
+        if (first >= 0)
+            filled |= QRect(first, y, last - first + 1, 1);
+    }
+    return filled;
+}
@@ -0,0 +1,68 @@
+#ifndef FLOODFILL_H
+#define FLOODFILL_H
+
+#include <QImage>
+#include <QRect>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Iterative scanline flood fill used by the paint bucket tool. Works directly on the raw scanlines of an ARGB32 image
+ */
+class FloodFill
+{
+public:
+    /**
+     * @brief Connectivity - which neighbours of a pixel count as touching it
+     */
+    enum class Connectivity
+    {
+        // Only the pixels left, right, above and below
+        FOUR,
+        // The four direct neighbours plus the diagonals
+        EIGHT
+    };
+
+    /**
+     * @brief Options - settings that control which pixels a fill reaches
+     */
+    struct Options
+    {
+        // The largest per-channel difference from the start color that still counts as a match
+        int tolerance = 0;
+        // Which neighbours the fill spreads to
+        Connectivity connectivity = Connectivity::FOUR;
+        // Fills every matching pixel on the image instead of only the connected region
+        bool global = false;
+    };
+
+    /**
+     * @brief fill - fills the region that matches the color at (x, y) with fillColor
+     * @param image - the ARGB32 image to fill in place
+     * @param x - x coordinate of the start pixel
+     * @param y - y coordinate of the start pixel
+     * @param fillColor - the color written into every matching pixel
+     * @param options - tolerance, connectivity and global mode for the fill
+     * @return the bounding rect of every pixel that was written, empty if nothing changed
+     */
+    static QRect fill(QImage &image, int x, int y, QRgb fillColor, const Options &options);
+
+private:
+    /**
+     * @brief matches - checks if a pixel is within the tolerance of the color being replaced
+     * @param pixel - the pixel to test
+     * @param target - the color at the start of the fill
+     * @param tolerance - the largest allowed per-channel difference
+     * @return true if the pixel should be filled
+     */
+    static bool matches(QRgb pixel, QRgb target, int tolerance);
+
+    /**
+     * @brief fillGlobal - fills every matching pixel in the image regardless of connectivity
+     * @return the bounding rect of the written pixels
+     */
+    static QRect fillGlobal(QImage &image, QRgb target, QRgb fillColor, int tolerance);
+};
+
+#endif // FLOODFILL_H
@@ -0,0 +1,55 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the frame selector's row painter.
+ */
+
+#include "framedelegate.h"
+#include "framelistmodel.h"
+#include <QPainter>
+
+namespace
+{
+    // Space around the thumbnail, the border is drawn inside it
+    const int CELL_MARGIN = 3;
+    const int BORDER_WIDTH = 2;
+}
+
+FrameDelegate::FrameDelegate(QObject *parent) : QStyledItemDelegate(parent)
+{
+}
+
+void FrameDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    painter->save();
+
+    // The thumbnail keeps its aspect ratio and is centered in the cell
+    QPixmap thumbnail = index.data(Qt::DecorationRole).value<QPixmap>();
+    QRect cell = option.rect.adjusted(CELL_MARGIN, CELL_MARGIN, -CELL_MARGIN, -CELL_MARGIN);
+    QRect target(QPoint(0, 0), thumbnail.size());
+    target.moveCenter(cell.center());
+    painter->drawPixmap(target, thumbnail);
+
+    QColor border;
+    if (index.data(FrameListModel::CURRENT_FRAME_ROLE).toBool())
+        border = Qt::blue;
+    else if (option.state & QStyle::State_Selected)
+        border = QColor("lightblue");
+    if (border.isValid())
+    {
+        painter->setPen(QPen(border, BORDER_WIDTH));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRoundedRect(cell.adjusted(1, 1, -1, -1), 4, 4);
+    }
+
+    painter->restore();
+}
+
+QSize FrameDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_UNUSED(option);
+    Q_UNUSED(index);
+    int side = FrameListModel::THUMBNAIL_SIZE + 2 * (CELL_MARGIN + BORDER_WIDTH);
+    return QSize(side, side);
+}
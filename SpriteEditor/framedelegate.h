@@ -0,0 +1,29 @@
+#ifndef FRAMEDELEGATE_H
+#define FRAMEDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Paints one row of the frame selector: the frame's thumbnail in a fixed size cell, a blue border around the
+ * frame being edited and a light blue border around the other selected frames. Every cell has the same size, so a
+ * view can lay out thousands of rows without asking for any of them
+ */
+class FrameDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief FrameDelegate - creates the delegate
+     * @param parent - owner of the delegate
+     */
+    explicit FrameDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+};
+
+#endif // FRAMEDELEGATE_H
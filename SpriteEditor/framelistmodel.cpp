@@ -0,0 +1,227 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the frame list shown by the frame selector.
+ */
+
+#include "framelistmodel.h"
+#include <QDataStream>
+#include <algorithm>
+
+namespace
+{
+    // Mime type of dragged frames, the data is the first row and the number of rows
+    const char FRAME_MIME_TYPE[] = "application/x-sprite-editor-frames";
+
+    // Milliseconds between thumbnails of the frame being edited, at most 10 a second
+    const int CURRENT_THUMBNAIL_INTERVAL = 100;
+}
+
+FrameListModel::FrameListModel(Model *model, QObject *parent)
+    : QAbstractListModel(parent), model(model), frameCount(int(model->getFrameCount())),
+      currentRow(int(model->getCurrentFrameIndex()))
+{
+    thumbnails = new ThumbnailService(THUMBNAIL_SIZE, this);
+    connect(thumbnails, &ThumbnailService::thumbnailReady, this, &FrameListModel::thumbnailReady);
+
+    currentThumbnailTimer = new QTimer(this);
+    currentThumbnailTimer->setSingleShot(true);
+    currentThumbnailTimer->setInterval(CURRENT_THUMBNAIL_INTERVAL);
+    connect(currentThumbnailTimer, &QTimer::timeout, this, &FrameListModel::refreshCurrent);
+
+    connect(model, &Model::framesInserted, this, &FrameListModel::insertFrames);
+    connect(model, &Model::framesRemoved, this, &FrameListModel::removeFrames);
+    connect(model, &Model::framesMoved, this, &FrameListModel::moveFrames);
+    connect(model, &Model::framesReversed, this, &FrameListModel::reverseFrames);
+    connect(model, &Model::framesReloaded, this, &FrameListModel::resetFrames);
+    connect(model, &Model::allFramesModified, this, &FrameListModel::invalidateAll);
+    connect(model, &Model::canvasUpdated, this, &FrameListModel::invalidateCurrent);
+    connect(model, &Model::frameModified, this, &FrameListModel::updateCurrentRow);
+    connect(model, &Model::requestNewSelectedFrameIndex, this, &FrameListModel::updateCurrentRow);
+}
+
+int FrameListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : frameCount;
+}
+
+QVariant FrameListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= frameCount)
+        return QVariant();
+
+    int row = index.row();
+    switch (role)
+    {
+    case Qt::DecorationRole:
+    {
+        // Only rows a view paints ask for their thumbnail, so hidden frames are never scaled. An outdated thumbnail
+        // is shown until the new one is ready. The current frame first has to store the canvas, which painting must
+        // not do, so its thumbnail is left to refreshCurrent
+        QPixmap thumbnail;
+        quint32 id = model->getFrameId(row);
+        quint64 generation = model->getFrameGeneration(row);
+        if (!thumbnails->find(id, generation, thumbnail))
+        {
+            if (row == int(model->getCurrentFrameIndex()))
+            {
+                if (!currentThumbnailTimer->isActive())
+                    currentThumbnailTimer->start();
+            }
+            else
+            {
+                thumbnails->request(id, generation, model->getStoredFrame(row));
+            }
+        }
+        return thumbnail;
+    }
+    case Qt::DisplayRole:
+        return row + 1;
+    case CURRENT_FRAME_ROLE:
+        return row == int(model->getCurrentFrameIndex());
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags FrameListModel::flags(const QModelIndex &index) const
+{
+    // Frames are dropped between rows, never onto one
+    if (!index.isValid())
+        return Qt::ItemIsDropEnabled;
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled;
+}
+
+Qt::DropActions FrameListModel::supportedDropActions() const
+{
+    return Qt::MoveAction;
+}
+
+QStringList FrameListModel::mimeTypes() const
+{
+    return {FRAME_MIME_TYPE};
+}
+
+QMimeData *FrameListModel::mimeData(const QModelIndexList &indexes) const
+{
+    if (indexes.isEmpty())
+        return nullptr;
+
+    // The selection is one contiguous run, only its ends are needed
+    auto [low, high] = std::minmax_element(indexes.begin(), indexes.end(), [](const QModelIndex &a, const QModelIndex &b)
+                                           { return a.row() < b.row(); });
+    QByteArray encoded;
+    QDataStream stream(&encoded, QIODevice::WriteOnly);
+    stream << low->row() << high->row() - low->row() + 1;
+
+    QMimeData *mimeData = new QMimeData();
+    mimeData->setData(FRAME_MIME_TYPE, encoded);
+    return mimeData;
+}
+
+bool FrameListModel::dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column,
+                                  const QModelIndex &parent)
+{
+    Q_UNUSED(column);
+    if (action != Qt::MoveAction || !data->hasFormat(FRAME_MIME_TYPE))
+        return false;
+
+    int first = 0;
+    int count = 0;
+    QDataStream stream(data->data(FRAME_MIME_TYPE));
+    stream >> first >> count;
+
+    // A drop past the last row or onto a row puts the frames at the end or in front of that row
+    int destination = row >= 0 ? row : (parent.isValid() ? parent.row() : frameCount);
+    model->moveFrames(first, count, destination);
+
+    // The rows already moved through framesMoved, reporting success would make the view delete the dragged rows
+    return false;
+}
+
+void FrameListModel::insertFrames(int first, int count)
+{
+    beginInsertRows(QModelIndex(), first, first + count - 1);
+    frameCount += count;
+    endInsertRows();
+    updateCurrentRow();
+}
+
+void FrameListModel::removeFrames(int first, int count)
+{
+    beginRemoveRows(QModelIndex(), first, first + count - 1);
+    frameCount -= count;
+    endRemoveRows();
+    updateCurrentRow();
+}
+
+void FrameListModel::moveFrames(int first, int count, int destination)
+{
+    // Thumbnails are cached by frame id, so moved rows keep theirs
+    beginMoveRows(QModelIndex(), first, first + count - 1, QModelIndex(), destination);
+    endMoveRows();
+    updateCurrentRow();
+}
+
+void FrameListModel::reverseFrames(int first, int count)
+{
+    emit dataChanged(index(first), index(first + count - 1));
+    updateCurrentRow();
+}
+
+void FrameListModel::resetFrames()
+{
+    beginResetModel();
+    frameCount = int(model->getFrameCount());
+    thumbnails->clear();
+    currentRow = int(model->getCurrentFrameIndex());
+    endResetModel();
+}
+
+void FrameListModel::invalidateAll()
+{
+    // Every frame has a new generation, the views ask for new thumbnails as they repaint
+    if (frameCount > 0)
+        emit dataChanged(index(0), index(frameCount - 1), {Qt::DecorationRole});
+}
+
+void FrameListModel::invalidateCurrent()
+{
+    // Strokes update the canvas for every pixel, the thumbnail only follows a few times a second
+    if (!currentThumbnailTimer->isActive())
+        currentThumbnailTimer->start();
+}
+
+void FrameListModel::refreshCurrent()
+{
+    // thumbnailReady repaints the row once the new thumbnail is made
+    size_t row = model->getCurrentFrameIndex();
+    if (int(row) >= frameCount)
+        return;
+    quint32 id = model->getFrameId(row);
+    quint64 generation = model->getFrameGeneration(row);
+    QPixmap thumbnail;
+    if (!thumbnails->find(id, generation, thumbnail))
+        thumbnails->request(id, generation, model->getFrameSnapshot(row));
+}
+
+void FrameListModel::thumbnailReady(quint32 id)
+{
+    int row = model->findFrame(id);
+    if (row >= 0 && row < frameCount)
+        emit dataChanged(index(row), index(row), {Qt::DecorationRole});
+}
+
+void FrameListModel::updateCurrentRow()
+{
+    int row = int(model->getCurrentFrameIndex());
+    if (row == currentRow)
+        return;
+    int previous = currentRow;
+    currentRow = row;
+    if (previous < frameCount)
+        emit dataChanged(index(previous), index(previous), {CURRENT_FRAME_ROLE});
+    if (row < frameCount)
+        emit dataChanged(index(row), index(row), {CURRENT_FRAME_ROLE});
+}
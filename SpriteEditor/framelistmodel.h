@@ -0,0 +1,111 @@
+#ifndef FRAMELISTMODEL_H
+#define FRAMELISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QMimeData>
+#include <QTimer>
+#include "models.h"
+#include "thumbnailservice.h"
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Presents the frames of the animation as a list for the frame selector. Rows follow the Model's insert,
+ * remove, move and reverse signals one change at a time, so views keep their scroll position and selection, and
+ * thumbnails are only made for the rows a view actually paints. Dragging rows within the list moves the frames
+ */
+class FrameListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Data roles on top of the standard ones
+     */
+    enum Role
+    {
+        // bool, true for the frame being edited
+        CURRENT_FRAME_ROLE = Qt::UserRole
+    };
+
+    // Width and height thumbnails are scaled to fit
+    static constexpr int THUMBNAIL_SIZE = 110;
+
+    /**
+     * @brief FrameListModel - lists the frames of a model
+     * @param model - the model whose frames are listed
+     * @param parent - owner of the list model
+     */
+    explicit FrameListModel(Model *model, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @brief data - the thumbnail as Qt::DecorationRole, the frame number as Qt::DisplayRole and whether the frame is
+     * the current one as CURRENT_FRAME_ROLE
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    Qt::DropActions supportedDropActions() const override;
+    QStringList mimeTypes() const override;
+    QMimeData *mimeData(const QModelIndexList &indexes) const override;
+
+    /**
+     * @brief dropMimeData - moves the dragged run of frames in front of the drop row
+     * @return false even when the frames moved, so the view does not also remove the dragged rows
+     */
+    bool dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column,
+                      const QModelIndex &parent) override;
+
+private slots:
+    void insertFrames(int first, int count);
+    void removeFrames(int first, int count);
+    void moveFrames(int first, int count, int destination);
+    void reverseFrames(int first, int count);
+    void resetFrames();
+
+    /**
+     * @brief invalidateAll - drops every thumbnail, used when every frame changed
+     */
+    void invalidateAll();
+
+    /**
+     * @brief invalidateCurrent - schedules a new thumbnail of the current frame after the canvas changed
+     */
+    void invalidateCurrent();
+
+    /**
+     * @brief refreshCurrent - stores the canvas into the current frame and asks for its new thumbnail
+     */
+    void refreshCurrent();
+
+    /**
+     * @brief thumbnailReady - repaints the row of a frame whose thumbnail was made
+     * @param id - the frame's id
+     */
+    void thumbnailReady(quint32 id);
+
+    /**
+     * @brief updateCurrentRow - repaints the rows that stopped or started being the current frame
+     */
+    void updateCurrentRow();
+
+private:
+    Model *model;
+
+    // Number of rows, only changed between the begin and end calls of a row change
+    int frameCount = 0;
+
+    // The row last reported as the current frame
+    int currentRow = 0;
+
+    // Thumbnails by frame id and generation, made on worker threads
+    ThumbnailService *thumbnails;
+
+    // Limits how often the thumbnail of the frame being edited is made again
+    QTimer *currentThumbnailTimer;
+};
+
+#endif // FRAMELISTMODEL_H
@@ -0,0 +1,193 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the frame scratch file.
+ */
+
+#include "framepager.h"
+#include <QDir>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTemporaryFile>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <map>
+
+namespace
+{
+    // The file grows by this much at a time, every segment is mapped once
+    const qint64 SEGMENT_SIZE = 64 * 1024 * 1024;
+
+    // Pages start on multiples of this, so reuse does not leave slivers too small for any frame
+    const qint64 ALIGNMENT = 256;
+
+    // Reading one byte per memory page is enough for the operating system to read the whole page in
+    const qint64 MEMORY_PAGE = 4096;
+}
+
+/**
+ * The scratch file and its free space, shared by the pager and every page so the file outlives whichever goes last
+ */
+struct FramePager::Storage
+{
+    QMutex mutex;
+    QTemporaryFile file;
+    // Set once the file could not be created, paging then stays off
+    bool failed = false;
+    // File offsets where the mapped segments start and their mappings, in file order
+    std::vector<qint64> segmentStarts;
+    std::vector<uchar *> segmentMaps;
+    // Unused ranges by file offset with their lengths, ranges in different segments are never merged
+    std::map<qint64, qint64> freeRanges;
+
+    /**
+     * Appends and maps one more segment of at least the given size, the caller holds the mutex
+     */
+    bool grow(qint64 minimum)
+    {
+        if (failed)
+            return false;
+        if (!file.isOpen())
+        {
+            file.setFileTemplate(QDir(QDir::tempPath()).filePath("sprite-editor-pages-XXXXXX"));
+            if (!file.open())
+            {
+                failed = true;
+                return false;
+            }
+        }
+
+        qint64 start = file.size();
+        qint64 length = std::max(SEGMENT_SIZE, minimum);
+        if (!file.resize(start + length))
+            return false;
+        uchar *map = file.map(start, length);
+        if (!map)
+        {
+            file.resize(start);
+            return false;
+        }
+        segmentStarts.push_back(start);
+        segmentMaps.push_back(map);
+        freeRanges.emplace(start, length);
+        return true;
+    }
+
+    /**
+     * The index of the segment holding a file offset
+     */
+    size_t segmentOf(qint64 offset) const
+    {
+        return size_t(std::upper_bound(segmentStarts.begin(), segmentStarts.end(), offset) - segmentStarts.begin()) - 1;
+    }
+
+    /**
+     * Returns a range to the free ranges, merging it with free neighbours of the same segment
+     */
+    void release(qint64 offset, qint64 length)
+    {
+        QMutexLocker lock(&mutex);
+        auto range = freeRanges.emplace(offset, length).first;
+
+        auto next = std::next(range);
+        if (next != freeRanges.end() && next->first == offset + length && segmentOf(next->first) == segmentOf(offset))
+        {
+            range->second += next->second;
+            freeRanges.erase(next);
+        }
+        if (range != freeRanges.begin())
+        {
+            auto previous = std::prev(range);
+            if (previous->first + previous->second == offset && segmentOf(previous->first) == segmentOf(offset))
+            {
+                previous->second += range->second;
+                freeRanges.erase(range);
+            }
+        }
+    }
+};
+
+FramePager::Page::Page(std::shared_ptr<Storage> storage, qint64 offset, qint64 length, qint64 capacity,
+                       const uchar *bytes)
+    : storage(std::move(storage)), offset(offset), length(length), capacity(capacity), bytes(bytes)
+{
+}
+
+FramePager::Page::~Page()
+{
+    storage->release(offset, capacity);
+}
+
+const uchar *FramePager::Page::data() const
+{
+    return bytes;
+}
+
+qint64 FramePager::Page::size() const
+{
+    return length;
+}
+
+FramePager::FramePager() : storage(std::make_shared<Storage>())
+{
+}
+
+std::shared_ptr<const FramePager::Page> FramePager::store(const QByteArray &bytes)
+{
+    Q_ASSERT(!bytes.isEmpty());
+    qint64 capacity = (bytes.size() + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+    QMutexLocker lock(&storage->mutex);
+    auto fits = [capacity](const std::pair<const qint64, qint64> &range)
+    { return range.second >= capacity; };
+    auto range = std::find_if(storage->freeRanges.begin(), storage->freeRanges.end(), fits);
+    if (range == storage->freeRanges.end())
+    {
+        if (!storage->grow(capacity))
+            return nullptr;
+        range = std::find_if(storage->freeRanges.begin(), storage->freeRanges.end(), fits);
+    }
+
+    qint64 offset = range->first;
+    qint64 remaining = range->second - capacity;
+    storage->freeRanges.erase(range);
+    if (remaining > 0)
+        storage->freeRanges.emplace(offset + capacity, remaining);
+
+    // Writing through the file rather than the mapping turns a full disk into an error instead of a crash, the
+    // flush makes the bytes visible through the mapping
+    if (!storage->file.seek(offset) || storage->file.write(bytes) != bytes.size() || !storage->file.flush())
+    {
+        lock.unlock();
+        storage->release(offset, capacity);
+        return nullptr;
+    }
+
+    size_t segment = storage->segmentOf(offset);
+    const uchar *mapped = storage->segmentMaps[segment] + (offset - storage->segmentStarts[segment]);
+    return std::shared_ptr<const Page>(new Page(storage, offset, bytes.size(), capacity, mapped));
+}
+
+void FramePager::prefetch(std::vector<std::shared_ptr<const Page>> pages)
+{
+    if (pages.empty())
+        return;
+
+    prefetching = QtConcurrent::run(
+        [pages = std::move(pages)]()
+        {
+            volatile uchar sink = 0;
+            for (const std::shared_ptr<const Page> &page : pages)
+            {
+                for (qint64 i = 0; i < page->size(); i += MEMORY_PAGE)
+                    sink = sink ^ page->data()[i];
+            }
+        });
+}
+
+qint64 FramePager::fileSize() const
+{
+    QMutexLocker lock(&storage->mutex);
+    return storage->file.isOpen() ? storage->file.size() : 0;
+}
@@ -0,0 +1,90 @@
+#ifndef FRAMEPAGER_H
+#define FRAMEPAGER_H
+
+#include <QByteArray>
+#include <QFuture>
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief A scratch file that holds packed frames the editor has no memory left for. The file grows in large
+ * segments that are memory mapped once, so reading a page back is a plain memory access and the operating system
+ * decides which parts stay cached. Pages are reference counted, the space of a page is reused once the last frame
+ * holding it lets go, and the file is deleted when the pager and every page are gone. Pages may be read and
+ * released from any thread
+ */
+class FramePager
+{
+public:
+    struct Storage;
+
+    /**
+     * @brief One block of bytes stored in the scratch file
+     */
+    class Page
+    {
+    public:
+        /**
+         * Gives the block's space back to the scratch file
+         */
+        ~Page();
+
+        /**
+         * @brief data - the stored bytes, mapped from the scratch file
+         */
+        const uchar *data() const;
+
+        /**
+         * @brief size - number of stored bytes
+         */
+        qint64 size() const;
+
+    private:
+        friend class FramePager;
+        Page(std::shared_ptr<Storage> storage, qint64 offset, qint64 length, qint64 capacity, const uchar *bytes);
+
+        std::shared_ptr<Storage> storage;
+        qint64 offset;
+        qint64 length;
+        // Bytes reserved in the file, length rounded up
+        qint64 capacity;
+        const uchar *bytes;
+    };
+
+    /**
+     * @brief FramePager - a pager whose scratch file is only created once the first page is stored
+     */
+    FramePager();
+
+    /**
+     * @brief store - copies bytes into the scratch file
+     * @param bytes - the bytes to store, not empty
+     * @return the page holding them, null if the scratch file could not be created or grown
+     */
+    std::shared_ptr<const Page> store(const QByteArray &bytes);
+
+    /**
+     * @brief prefetch - reads pages on a worker thread so the operating system has them cached before they are needed
+     * @param pages - the pages to read, kept alive until they were read
+     */
+    void prefetch(std::vector<std::shared_ptr<const Page>> pages);
+
+    /**
+     * @brief fileSize - bytes the scratch file takes on disk
+     */
+    qint64 fileSize() const;
+
+private:
+    std::shared_ptr<Storage> storage;
+
+    /**
+     * @brief prefetching - the last prefetch started, it is never waited for
+     */
+    QFuture<void> prefetching;
+};
+
+#endif // FRAMEPAGER_H
@@ -0,0 +1,422 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the streaming legacy JSON project reader and writer.
+ */
+
+#include "legacyprojectfile.h"
+#include "pixelview.h"
+#include <QFile>
+#include <QSaveFile>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // Bytes pulled from the file per read
+    const qint64 READ_CHUNK = 64 * 1024;
+
+    // Numbers with more digits than this saturate at MAX_NUMBER, no value the format stores comes close
+    const int MAX_DIGITS = 18;
+    const qint64 MAX_NUMBER = 999999999999999999;
+
+    // Most frames a project may count, and most of them it may leave out to be filled in blank
+    const qint64 MAX_FRAME_COUNT = 100000;
+    const qint64 MAX_MISSING_FRAMES = 1000;
+}
+
+LegacyProjectFile::Tokenizer::Tokenizer(QIODevice &device) : device(device)
+{
+}
+
+int LegacyProjectFile::Tokenizer::peek()
+{
+    if (position == buffer.size())
+    {
+        buffer = device.read(READ_CHUNK);
+        position = 0;
+        if (buffer.isEmpty())
+            return -1;
+    }
+    return uchar(buffer[position]);
+}
+
+LegacyProjectFile::Tokenizer::Token LegacyProjectFile::Tokenizer::next()
+{
+    int c = peek();
+    while (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+    {
+        position++;
+        c = peek();
+    }
+    if (c < 0)
+        return Token::END;
+
+    position++;
+    switch (c)
+    {
+    case '{':
+        return Token::OBJECT_BEGIN;
+    case '}':
+        return Token::OBJECT_END;
+    case '[':
+        return Token::ARRAY_BEGIN;
+    case ']':
+        return Token::ARRAY_END;
+    case ':':
+        return Token::COLON;
+    case ',':
+        return Token::COMMA;
+    case '"':
+        text.clear();
+        while ((c = peek()) >= 0)
+        {
+            position++;
+            if (c == '"')
+                return Token::STRING;
+            text.push_back(char(c));
+            // Keep escaped characters, including quotes, as part of the string
+            if (c == '\\' && (c = peek()) >= 0)
+            {
+                position++;
+                text.push_back(char(c));
+            }
+        }
+        return Token::INVALID;
+    default:
+        break;
+    }
+
+    if (c == '-' || (c >= '0' && c <= '9'))
+    {
+        bool negative = c == '-';
+        qint64 value = negative ? 0 : c - '0';
+        int digits = negative ? 0 : 1;
+        while ((c = peek()) >= '0' && c <= '9')
+        {
+            position++;
+            value = ++digits > MAX_DIGITS ? MAX_NUMBER : value * 10 + (c - '0');
+        }
+        // Drop any fraction or exponent, the format only stores integers
+        while (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-' || (c >= '0' && c <= '9'))
+        {
+            position++;
+            c = peek();
+        }
+        number = negative ? -value : value;
+        return digits > 0 ? Token::NUMBER : Token::INVALID;
+    }
+
+    if (c >= 'a' && c <= 'z')
+    {
+        // true, false or null
+        while ((c = peek()) >= 'a' && c <= 'z')
+            position++;
+        return Token::LITERAL;
+    }
+    return Token::INVALID;
+}
+
+bool LegacyProjectFile::skipValue(Tokenizer &tokens, Tokenizer::Token first)
+{
+    using Token = Tokenizer::Token;
+
+    if (first == Token::STRING || first == Token::NUMBER || first == Token::LITERAL)
+        return true;
+    if (first != Token::OBJECT_BEGIN && first != Token::ARRAY_BEGIN)
+        return false;
+
+    // Nested containers only need their depth tracked
+    int depth = 1;
+    while (depth > 0)
+    {
+        Token token = tokens.next();
+        if (token == Token::OBJECT_BEGIN || token == Token::ARRAY_BEGIN)
+            depth++;
+        else if (token == Token::OBJECT_END || token == Token::ARRAY_END)
+            depth--;
+        else if (token == Token::END || token == Token::INVALID)
+            return false;
+    }
+    return true;
+}
+
+bool LegacyProjectFile::read(const QString &filePath, std::vector<QImage> &frames, int &size, QString &error,
+                             const ProjectFile::Progress &progress)
+{
+    // Repeated frames share the image of the frame they repeat
+    std::vector<QImage> loaded;
+    auto collect = [&loaded](const QImage &frame, qsizetype repeats)
+    { loaded.push_back(repeats >= 0 ? loaded[size_t(repeats)] : frame); };
+    if (!read(filePath, collect, size, error, progress))
+    {
+        return false;
+    }
+    frames = std::move(loaded);
+    return true;
+}
+
+bool LegacyProjectFile::read(const QString &filePath, const ProjectFile::FrameSink &sink, int &size, QString &error,
+                             const ProjectFile::Progress &progress)
+{
+    using Token = Tokenizer::Token;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        error = "Unable to open the file.";
+        return false;
+    }
+
+    const QString formatError = "The JSON format is incorrect.";
+    Tokenizer tokens(file);
+    if (tokens.next() != Token::OBJECT_BEGIN)
+    {
+        error = formatError;
+        return false;
+    }
+
+    int width = 0;
+    qint64 frameCount = 0;
+    int frameSize = 0;
+    qint64 loaded = 0;
+    // Pixels of the frame being read and the frame image they are copied into, both reused for every frame
+    std::vector<QRgb> pending;
+    QImage frame;
+
+    Token token = tokens.next();
+    while (token != Token::OBJECT_END)
+    {
+        if (token != Token::STRING || tokens.next() != Token::COLON)
+        {
+            error = formatError;
+            return false;
+        }
+        std::string key = tokens.text;
+        Token value = tokens.next();
+
+        if (key == "width" && value == Token::NUMBER)
+        {
+            width = int(qBound<qint64>(0, tokens.number, ProjectFile::MAX_SIZE + 1));
+        }
+        else if (key == "frameCount" && value == Token::NUMBER)
+        {
+            frameCount = tokens.number;
+            if (frameCount < 0 || frameCount > MAX_FRAME_COUNT)
+            {
+                error = formatError;
+                return false;
+            }
+        }
+        else if (key == "frames" && value == Token::ARRAY_BEGIN)
+        {
+            Token element = tokens.next();
+            while (element != Token::ARRAY_END)
+            {
+                if (element != Token::ARRAY_BEGIN)
+                {
+                    error = formatError;
+                    return false;
+                }
+
+                // Gather one frame's channels four at a time, pixels past the largest possible frame are dropped
+                pending.clear();
+                qsizetype limit = frameSize > 0 ? frameSize : (width > 0 ? width : ProjectFile::MAX_SIZE);
+                limit *= limit;
+                int channels[4];
+                int channel = 0;
+                Token item = tokens.next();
+                while (item != Token::ARRAY_END)
+                {
+                    if (item != Token::NUMBER)
+                    {
+                        error = formatError;
+                        return false;
+                    }
+                    channels[channel++] = int(tokens.number);
+                    if (channel == 4 && qsizetype(pending.size()) < limit)
+                    {
+                        pending.push_back(qRgba(channels[0], channels[1], channels[2], channels[3]));
+                    }
+                    channel %= 4;
+                    item = tokens.next();
+                    if (item == Token::COMMA)
+                        item = tokens.next();
+                    else if (item != Token::ARRAY_END)
+                    {
+                        error = formatError;
+                        return false;
+                    }
+                }
+
+                // Size the frame from the width if it was given already, otherwise from its pixel count
+                if (frameSize == 0)
+                {
+                    frameSize = width > 0 ? width : int(std::lround(std::sqrt(double(pending.size()))));
+                    if (frameSize <= 0 || frameSize > ProjectFile::MAX_SIZE ||
+                        (width == 0 && qsizetype(frameSize) * frameSize != qsizetype(pending.size())))
+                    {
+                        error = formatError;
+                        return false;
+                    }
+                }
+
+                if (frame.isNull())
+                    frame = QImage(frameSize, frameSize, QImage::Format_ARGB32);
+                frame.fill(0);
+                PixelView pixels(frame);
+                qsizetype count = std::min<qsizetype>(pending.size(), qsizetype(frameSize) * frameSize);
+                for (int y = 0; qsizetype(y) * frameSize < count; y++)
+                {
+                    qsizetype rowCount = std::min<qsizetype>(frameSize, count - qsizetype(y) * frameSize);
+                    std::memcpy(pixels.row(y), pending.data() + qsizetype(y) * frameSize, rowCount * sizeof(QRgb));
+                }
+                sink(frame, -1);
+                loaded++;
+                if (progress && !progress(file.pos(), file.size()))
+                {
+                    return false;
+                }
+
+                element = tokens.next();
+                if (element == Token::COMMA)
+                    element = tokens.next();
+                else if (element != Token::ARRAY_END)
+                {
+                    error = formatError;
+                    return false;
+                }
+            }
+        }
+        else if (!skipValue(tokens, value))
+        {
+            error = formatError;
+            return false;
+        }
+
+        token = tokens.next();
+        if (token == Token::COMMA)
+            token = tokens.next();
+        else if (token != Token::OBJECT_END)
+        {
+            error = formatError;
+            return false;
+        }
+    }
+
+    // A width given after the frames must agree with the size they were read at
+    if (width <= 0 || width > ProjectFile::MAX_SIZE || (frameSize != 0 && frameSize != width))
+    {
+        error = formatError;
+        return false;
+    }
+
+    // Frames the file counts but does not store are blank. Only a few may be missing, so a short file cannot claim
+    // an animation too long to hold, and they all share one image
+    if (frameCount - loaded > MAX_MISSING_FRAMES)
+    {
+        error = formatError;
+        return false;
+    }
+    qint64 firstBlank = loaded;
+    while (loaded == 0 || loaded < frameCount)
+    {
+        if (loaded == firstBlank)
+        {
+            QImage blank(width, width, QImage::Format_ARGB32);
+            blank.fill(0);
+            sink(blank, -1);
+        }
+        else
+        {
+            sink(QImage(), firstBlank);
+        }
+        loaded++;
+    }
+
+    size = width;
+    return true;
+}
+
+void LegacyProjectFile::appendChannel(QByteArray &out, int value)
+{
+    // Channels are 0-255, so at most three digits
+    char digits[3];
+    int length = 0;
+    if (value >= 100)
+        digits[length++] = char('0' + value / 100);
+    if (value >= 10)
+        digits[length++] = char('0' + value / 10 % 10);
+    digits[length++] = char('0' + value % 10);
+    out.append(digits, length);
+}
+
+bool LegacyProjectFile::write(const QString &filePath, qsizetype frameCount, const ProjectFile::FrameSource &frameAt,
+                              QString &error, const ProjectFile::Progress &progress)
+{
+    if (frameCount <= 0)
+    {
+        error = "There are no frames to save.";
+        return false;
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        error = file.errorString();
+        return false;
+    }
+
+    QImage frame = frameAt(0);
+    QByteArray out;
+    out.append("{\n    \"width\": ");
+    out.append(QByteArray::number(frame.width()));
+    out.append(",\n    \"frameCount\": ");
+    out.append(QByteArray::number(frameCount));
+    out.append(",\n    \"frames\": [");
+    file.write(out);
+
+    // Each frame is written as one line, built in a buffer that is reused for every frame
+    for (qsizetype i = 0; i < frameCount; i++)
+    {
+        if (i > 0)
+            frame = frameAt(i);
+        out.clear();
+        out.append(i == 0 ? "\n        [" : ",\n        [");
+        ConstPixelView pixels(frame);
+        for (int y = 0; y < pixels.height(); y++)
+        {
+            const QRgb *row = pixels.row(y);
+            for (int x = 0; x < pixels.width(); x++)
+            {
+                if (y != 0 || x != 0)
+                    out.append(',');
+                appendChannel(out, qRed(row[x]));
+                out.append(',');
+                appendChannel(out, qGreen(row[x]));
+                out.append(',');
+                appendChannel(out, qBlue(row[x]));
+                out.append(',');
+                appendChannel(out, qAlpha(row[x]));
+            }
+        }
+        out.append(']');
+        if (file.write(out) != out.size())
+        {
+            error = file.errorString();
+            return false;
+        }
+        if (progress && !progress(qint64(i) + 1, qint64(frameCount)))
+        {
+            return false;
+        }
+    }
+
+    if (file.write("\n    ]\n}\n") < 0 || !file.commit())
+    {
+        error = file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,118 @@
+#ifndef LEGACYPROJECTFILE_H
+#define LEGACYPROJECTFILE_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QIODevice>
+#include <QString>
+#include "projectfile.h"
+#include <string>
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Streams the legacy JSON .ssp format, an object with "width", "frameCount" and "frames", where every frame is
+ * an array of red, green, blue and alpha integers in row order. The file is tokenized in small chunks and pixels go
+ * straight into frame images, so memory use beyond the frames themselves does not grow with the project
+ */
+class LegacyProjectFile
+{
+public:
+    /**
+     * @brief write - saves frames in the legacy format, one frame at a time
+     * "width" is written first so streaming readers know the frame size before the pixels arrive
+     * @param filePath - destination file, replaced if it exists
+     * @param frameCount - number of frames to save, at least one
+     * @param frame - gives each frame to save, all square ARGB32 images of the same size
+     * @param error - set to a description of the problem when saving fails
+     * @param progress - optional, told the number of frames written after each frame
+     * @return true if the file was written, false on errors or when cancelled, leaving the destination untouched
+     */
+    static bool write(const QString &filePath, qsizetype frameCount, const ProjectFile::FrameSource &frame,
+                      QString &error, const ProjectFile::Progress &progress = {});
+
+    /**
+     * @brief read - loads every frame of a legacy project
+     * Keys may come in any order. Frames whose size is not known yet are buffered one at a time and sized from their
+     * pixel count, frames the file counts but does not store are blank
+     * @param filePath - the file to load
+     * @param frames - filled with the decoded ARGB32 frames
+     * @param size - set to the canvas size
+     * @param error - set to a description of the problem when loading fails
+     * @param progress - optional, told the number of bytes read after each frame
+     * @return true if the file was read, frames and size are left untouched otherwise
+     */
+    static bool read(const QString &filePath, std::vector<QImage> &frames, int &size, QString &error,
+                     const ProjectFile::Progress &progress = {});
+
+    /**
+     * @brief read - loads a legacy project one frame at a time, like the read above
+     * @param filePath - the file to load
+     * @param sink - given each frame as it is read, in file order, missing frames come last as repeats of one blank
+     * @param size - set to the canvas size
+     * @param error - set to a description of the problem when loading fails
+     * @param progress - optional, told the number of bytes read after each frame
+     * @return true if the file was read, size is left untouched otherwise and the frames given so far are of no use
+     */
+    static bool read(const QString &filePath, const ProjectFile::FrameSink &sink, int &size, QString &error,
+                     const ProjectFile::Progress &progress = {});
+
+private:
+    /**
+     * @brief Pulls JSON tokens out of a device through a fixed size buffer
+     */
+    class Tokenizer
+    {
+    public:
+        enum class Token
+        {
+            OBJECT_BEGIN,
+            OBJECT_END,
+            ARRAY_BEGIN,
+            ARRAY_END,
+            COLON,
+            COMMA,
+            STRING,
+            NUMBER,
+            LITERAL,
+            END,
+            INVALID
+        };
+
+        explicit Tokenizer(QIODevice &device);
+
+        /**
+         * @brief next - reads the next token, its value is in text or number
+         */
+        Token next();
+
+        // The last STRING token, without quotes and with escapes left as they are
+        std::string text;
+        // The last NUMBER token, fractions are truncated
+        qint64 number = 0;
+
+    private:
+        /**
+         * @brief peek - returns the next byte without consuming it, or -1 at the end of the device
+         */
+        int peek();
+
+        QIODevice &device;
+        QByteArray buffer;
+        qsizetype position = 0;
+    };
+
+    /**
+     * @brief skipValue - skips over one value of any kind whose first token was already read
+     */
+    static bool skipValue(Tokenizer &tokens, Tokenizer::Token first);
+
+    /**
+     * @brief appendChannel - appends a 0-255 integer as decimal text
+     */
+    static void appendChannel(QByteArray &out, int value);
+};
+
+#endif // LEGACYPROJECTFILE_H
@@ -14,6 +14,9 @@ int main(int argc, char *argv[])
 {
     // Qt application instance
     QApplication a(argc, argv);
+    // Names the settings and application data folder, where autosave keeps its journal
+    a.setOrganizationName("CS3505");
+    a.setApplicationName("Sprite Editor");
 
     // setting colors
     QPalette darkPalette;
@@ -38,6 +41,9 @@ int main(int argc, char *argv[])
     // Display the main window
     w.show();
 
+    // Offer to restore edits from a session that did not close cleanly
+    m.recoverAutosave();
+
     // Execute the application event loop
     return a.exec();
 }
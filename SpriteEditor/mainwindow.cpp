@@ -9,6 +9,9 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include <QtMath>
+#include <QApplication>
+#include <QAction>
+#include <QFileDialog>
 
 MainWindow::MainWindow(Model *model, QWidget *parent)
     : QMainWindow(parent), ui(new Ui::MainWindow), model(model)
@@ -22,6 +25,13 @@ MainWindow::MainWindow(Model *model, QWidget *parent)
     scene = new QGraphicsScene(this);
     ui->graphicsView->setScene(scene);
 
+    // Scene items stay alive for the whole session and are refreshed in place
+    backgroundItem = scene->addPixmap(QPixmap());
+    canvasLayer = new CanvasLayer();
+    scene->addItem(canvasLayer);
+    previewLayer = new CanvasLayer();
+    scene->addItem(previewLayer);
+
     createCanvas();
 
     // Set palette sliders
@@ -36,7 +46,7 @@ MainWindow::MainWindow(Model *model, QWidget *parent)
     // Background
     createBg();
 
-    updateView();
+    updateView(QRect(0, 0, model->getCanvasSize(), model->getCanvasSize()));
 
     // Canvas updating
     connect(model, &Model::canvasUpdated,
@@ -113,23 +123,248 @@ MainWindow::MainWindow(Model *model, QWidget *parent)
             &Displays::setSelectedFrameIndex);
     connect(model,
             &Model::framesReloaded,
-            displays,
-            &Displays::rebuildFrameButtonsFromModel);
-    connect(model,
-            &Model::requestWindowResize,
             this,
-            &MainWindow::resizeWindow);
+            &MainWindow::refreshCanvasSize);
+
+    // Paint bucket options
+    connect(ui->fillToleranceBox,
+            &QSpinBox::valueChanged,
+            model,
+            &Model::setFillTolerance);
+    connect(ui->fillDiagonalCheck,
+            &QCheckBox::toggled,
+            model,
+            &Model::setFillDiagonal);
+    connect(ui->fillGlobalCheck,
+            &QCheckBox::toggled,
+            model,
+            &Model::setFillGlobal);
+    connect(ui->fillShapesCheck,
+            &QCheckBox::toggled,
+            model,
+            &Model::setShapeFilled);
+
+    // Brush options
+    connect(ui->brushSizeBox,
+            &QSpinBox::valueChanged,
+            model,
+            &Model::setBrushSize);
+    connect(ui->brushShapeBox,
+            &QComboBox::currentIndexChanged,
+            this,
+            &MainWindow::brushShapeChanged);
+    connect(ui->brushDitherBox,
+            &QComboBox::currentIndexChanged,
+            this,
+            [this](int index)
+            { model->setBrushDither(static_cast<Brush::Dither>(index)); });
 
     // Mirror/Rotate connections
-    connect(ui->mirrorBttn,
+    initializeTransformButtons();
+
+    // Background save/load progress
+    initializeProjectProgress();
+
+    // Frame memory, it only changes when frames are added, removed, replaced or switched
+    frameMemoryLabel = new QLabel(this);
+    ui->statusbar->addPermanentWidget(frameMemoryLabel);
+    connect(model,
+            &Model::frameModified,
+            this,
+            &MainWindow::updateFrameMemoryLabel);
+    connect(model,
+            &Model::framesReloaded,
+            this,
+            &MainWindow::updateFrameMemoryLabel);
+    connect(model,
+            &Model::allFramesModified,
+            this,
+            &MainWindow::updateFrameMemoryLabel);
+    updateFrameMemoryLabel();
+
+    // Right-clicking the memory text lets the user cap it, frames not in use are then packed
+    QAction *memoryBudgetAction = new QAction("Set Frame Memory Budget...", frameMemoryLabel);
+    connect(memoryBudgetAction,
+            &QAction::triggered,
+            this,
+            &MainWindow::setFrameMemoryBudget);
+    frameMemoryLabel->setContextMenuPolicy(Qt::ActionsContextMenu);
+    frameMemoryLabel->addAction(memoryBudgetAction);
+
+    // Right-clicking the duplicate frame button offers to find frames that are already duplicates
+    QAction *findDuplicatesAction = new QAction("Find Duplicate Frames", ui->dublicateFrameButton);
+    connect(findDuplicatesAction,
+            &QAction::triggered,
+            this,
+            &MainWindow::findDuplicateFrames);
+    ui->dublicateFrameButton->setContextMenuPolicy(Qt::ActionsContextMenu);
+    ui->dublicateFrameButton->addAction(findDuplicatesAction);
+} // End of constructor
+
+void MainWindow::updateFrameMemoryLabel()
+{
+    TiledFrame::Usage usage = model->getFrameMemoryUsage();
+    QString text = QString("Frames: %1 KB of %2 KB, tiles shared %3x")
+                       .arg(usage.bytes / 1024)
+                       .arg(usage.flatBytes / 1024)
+                       .arg(usage.sharingRatio(), 0, 'f', 1);
+    if (usage.packedFrames > 0)
+        text += QString(", %1 packed").arg(usage.packedFrames);
+    if (usage.pagedFrames > 0)
+        text += QString(", %1 paged out (%2 KB)").arg(usage.pagedFrames).arg(usage.pagedBytes / 1024);
+    frameMemoryLabel->setText(text);
+}
+
+void MainWindow::setFrameMemoryBudget()
+{
+    bool ok;
+    const qint64 megabyte = 1024 * 1024;
+    int budget = QInputDialog::getInt(this,
+                                      "Frame Memory Budget",
+                                      "Megabytes the frames may use, 0 for no limit:",
+                                      int(model->getFrameMemoryBudget() / megabyte),
+                                      0,
+                                      1024 * 1024,
+                                      1,
+                                      &ok);
+    if (!ok)
+        return;
+    model->setFrameMemoryBudget(budget * megabyte);
+    updateFrameMemoryLabel();
+}
+
+void MainWindow::findDuplicateFrames()
+{
+    qint64 bytesBefore = model->getFrameMemoryUsage().bytes;
+    std::vector<std::vector<size_t>> groups = model->findDuplicateFrames();
+    qint64 bytesFreed = bytesBefore - model->getFrameMemoryUsage().bytes;
+    updateFrameMemoryLabel();
+
+    if (groups.empty())
+    {
+        QMessageBox::information(this, "Duplicate Frames", "No two frames are identical.");
+        return;
+    }
+
+    // Frames are numbered from 1 for the user, long lists are cut short
+    const size_t maxListed = 20;
+    QStringList lines;
+    for (size_t i = 0; i < groups.size() && i < maxListed; i++)
+    {
+        QStringList numbers;
+        for (size_t index : groups[i])
+            numbers << QString::number(index + 1);
+        lines << "Frames " + numbers.join(", ");
+    }
+    if (groups.size() > maxListed)
+        lines << QString("and %1 more groups").arg(groups.size() - maxListed);
+
+    QMessageBox::information(this,
+                             "Duplicate Frames",
+                             "These frames are identical and now share their pixels:\n" + lines.join("\n") +
+                                 QString("\n\n%1 KB freed.").arg(std::max<qint64>(bytesFreed, 0) / 1024));
+}
+
+void MainWindow::initializeProjectProgress()
+{
+    projectProgress = new QProgressBar(this);
+    projectProgress->setRange(0, 100);
+    projectProgress->setMaximumWidth(200);
+    projectProgress->hide();
+    projectCancelButton = new QPushButton("Cancel", this);
+    projectCancelButton->hide();
+    ui->statusbar->addPermanentWidget(projectProgress);
+    ui->statusbar->addPermanentWidget(projectCancelButton);
+
+    connect(projectCancelButton,
             &QPushButton::clicked,
             model,
-            &Model::mirrorFrame);
+            &Model::cancelProjectTask);
+    connect(model,
+            &Model::projectTaskStarted,
+            this,
+            [this](const QString &description)
+            {
+                ui->statusbar->showMessage(description);
+                projectProgress->setValue(0);
+                projectProgress->show();
+                projectCancelButton->show();
+            });
+    connect(model,
+            &Model::projectTaskProgress,
+            projectProgress,
+            &QProgressBar::setValue);
+    connect(model,
+            &Model::projectTaskFinished,
+            this,
+            [this]()
+            {
+                ui->statusbar->clearMessage();
+                projectProgress->hide();
+                projectCancelButton->hide();
+            });
+}
+
+void MainWindow::brushShapeChanged(int index)
+{
+    Brush::Shape shape = static_cast<Brush::Shape>(index);
+    if (shape == Brush::Shape::CUSTOM)
+    {
+        QString fileName = QFileDialog::getOpenFileName(this, "Choose Brush Stamp", "", "Images (*.png *.bmp *.gif *.jpg)");
+        QImage stamp(fileName);
+        if (fileName.isEmpty() || stamp.isNull())
+        {
+            // Fall back to the square brush, which calls this again with the new index
+            ui->brushShapeBox->setCurrentIndex(static_cast<int>(Brush::Shape::SQUARE));
+            return;
+        }
+        model->setCustomBrushStamp(stamp);
+    }
+    model->setBrushShape(shape);
+}
+
+void MainWindow::initializeTransformButtons()
+{
+    using Operation = FrameTransform::Operation;
+
+    // Shift+click applies the button's transform to every frame
+    connect(ui->mirrorBttn,
+            &QToolButton::clicked,
+            this,
+            [this]()
+            { model->transformFrames(Operation::FLIP_HORIZONTAL, QApplication::keyboardModifiers().testFlag(Qt::ShiftModifier)); });
     connect(ui->rotateBttn,
-            &QPushButton::clicked,
-            model,
-            &Model::rotateFrame);
-} // End of constructor
+            &QToolButton::clicked,
+            this,
+            [this]()
+            { model->transformFrames(Operation::ROTATE_90, QApplication::keyboardModifiers().testFlag(Qt::ShiftModifier)); });
+
+    // Right-click menus list every transform for the current frame and for all frames
+    auto addTransformActions = [this](QToolButton *button, const QList<QPair<QString, Operation>> &operations)
+    {
+        button->setContextMenuPolicy(Qt::ActionsContextMenu);
+        for (bool allFrames : {false, true})
+        {
+            for (const QPair<QString, Operation> &operation : operations)
+            {
+                QString text = allFrames ? operation.first + " (All Frames)" : operation.first;
+                QAction *action = new QAction(text, button);
+                Operation op = operation.second;
+                connect(action, &QAction::triggered, this, [this, op, allFrames]()
+                        { model->transformFrames(op, allFrames); });
+                button->addAction(action);
+            }
+        }
+    };
+    addTransformActions(ui->mirrorBttn, {{"Flip Horizontal", Operation::FLIP_HORIZONTAL},
+                                         {"Flip Vertical", Operation::FLIP_VERTICAL},
+                                         {"Transpose", Operation::TRANSPOSE}});
+    addTransformActions(ui->rotateBttn, {{"Rotate Clockwise", Operation::ROTATE_90},
+                                         {"Rotate Half Turn", Operation::ROTATE_180},
+                                         {"Rotate Counter Clockwise", Operation::ROTATE_270}});
+    ui->mirrorBttn->setToolTip("Mirror the frame. Shift+click mirrors every frame, right-click for more");
+    ui->rotateBttn->setToolTip("Rotate the frame. Shift+click rotates every frame, right-click for more");
+}
 
 void MainWindow::initializeButtons()
 {
@@ -185,16 +420,19 @@ void MainWindow::mousePressEvent(QMouseEvent *event)
                 y >= 0 && y < model->getImage()->height())
             {
                 drawing = true;
-                currPixel = scenePos;
+                currPixel = QPoint(x, y);
+
+                // Each event is one edit, so it produces at most one canvas update
+                model->beginEdit();
 
                 // Handle tool-specific actions
                 switch (currTool)
                 {
                 case Tool::BRUSH:
-                    model->setPixelTracker(x, y, userColor);
+                    model->strokeLine(x, y, x, y, userColor);
                     break;
                 case Tool::ERASER:
-                    model->erasePixel(x, y);
+                    model->eraseLine(x, y, x, y);
                     break;
                 case Tool::EYE:
                     palette->updateSlidersToColor(model->getImage()->pixelColor(x, y));
@@ -206,12 +444,24 @@ void MainWindow::mousePressEvent(QMouseEvent *event)
                 case Tool::ELLIPSE:
                     model->shapeStart(x, y);
                     break;
+                case Tool::LINE:
+                    // Shift+click continues a polyline from the end of the last line
+                    if (hasLineEnd && QApplication::keyboardModifiers().testFlag(Qt::ShiftModifier))
+                    {
+                        model->shapeStart(lineEnd.x(), lineEnd.y());
+                        model->lineShape(x, y, userColor);
+                    }
+                    else
+                    {
+                        model->shapeStart(x, y);
+                    }
+                    break;
                 case Tool::PAINT:
                     model->paintBucket(x, y, userColor);
                 default:
                     break;
                 }
-                updateView();
+                model->endEdit();
             }
         }
     }
@@ -248,31 +498,57 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
 
             if (mouseEvent->buttons() & Qt::LeftButton)
             {
-                // Check if moving from current pixel position & if in image bounds
-                if ((x != currPixel.x() || y != currPixel.y()) && x >= 0 && x < model->getImage()->width() &&
-                    y >= 0 && y < model->getImage()->height())
+                QPoint pixel(x, y);
+                bool inBounds = x >= 0 && x < model->getImage()->width() &&
+                                y >= 0 && y < model->getImage()->height();
+
+                // A drag that was pressed outside the canvas starts its stroke where it enters
+                if (!drawing && inBounds)
                 {
-                    // Handle tool-specific actions
+                    drawing = true;
+                    currPixel = pixel;
+                    model->beginEdit();
+                    if (currTool == Tool::BRUSH)
+                        model->strokeLine(x, y, x, y, userColor);
+                    else if (currTool == Tool::ERASER)
+                        model->eraseLine(x, y, x, y);
+                    else if (currTool == Tool::RECTANGLE || currTool == Tool::ELLIPSE || currTool == Tool::LINE)
+                        model->shapeStart(x, y);
+                    model->endEdit();
+                }
+
+                // Check if moving from current pixel position
+                if (drawing && pixel != currPixel)
+                {
+                    // Handle tool-specific actions. Brush and eraser cover every pixel between the two
+                    // positions, so fast movements leave no gaps; the model clips the line to the canvas
+                    model->beginEdit();
                     switch (currTool)
                     {
                     case Tool::BRUSH:
-                        model->setPixelTracker(x, y, userColor);
+                        model->strokeLine(currPixel.x(), currPixel.y(), x, y, userColor);
                         break;
                     case Tool::ERASER:
-                        model->erasePixel(x, y);
+                        model->eraseLine(currPixel.x(), currPixel.y(), x, y);
                         break;
                     case Tool::RECTANGLE:
-                        model->rectangleShape(x, y, userColor);
+                        if (inBounds)
+                            model->rectangleShape(x, y, userColor);
                         break;
                     case Tool::ELLIPSE:
-                        model->ellipseShape(x, y, userColor);
+                        if (inBounds)
+                            model->ellipseShape(x, y, userColor);
+                        break;
+                    case Tool::LINE:
+                        if (inBounds)
+                            model->lineShape(x, y, userColor);
                         break;
                     default:
                         break;
                     }
+                    model->endEdit();
                     // update current pixel
-                    currPixel = scenePos;
-                    updateView();
+                    currPixel = pixel;
                 }
             }
         }
@@ -289,25 +565,34 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
                 // Check if in bounds, then handle tool-specific actions
                 int x = static_cast<int>(scenePos.x());
                 int y = static_cast<int>(scenePos.y());
+                model->beginEdit();
                 if (x >= 0 && x < model->getImage()->width() &&
                     y >= 0 && y < model->getImage()->height() &&
-                    (currTool == Tool::RECTANGLE || currTool == Tool::ELLIPSE))
+                    (currTool == Tool::RECTANGLE || currTool == Tool::ELLIPSE || currTool == Tool::LINE))
                 {
+                    // A click without dragging still draws a one pixel line
+                    if (currTool == Tool::LINE && drawing)
+                    {
+                        model->lineShape(x, y, userColor);
+                        lineEnd = QPoint(x, y);
+                        hasLineEnd = true;
+                    }
                     model->mergeShapePreview();
                 }
                 model->clearNonCanvas();
+                model->endEdit();
+                drawing = false;
             }
         }
     }
     return QObject::eventFilter(obj, event);
 }
 
-void MainWindow::updateView()
+void MainWindow::updateView(const QRect &dirty)
 {
-    scene->clear();
-    scene->addPixmap(background);
-    scene->addPixmap(QPixmap::fromImage(*model->getImage()));
-    scene->addPixmap(QPixmap::fromImage(*model->getShapePreview()));
+    // Only the changed area of each layer is uploaded again
+    canvasLayer->refresh(*model->getImage(), dirty);
+    previewLayer->refresh(*model->getShapePreview(), dirty);
 }
 
 void MainWindow::on_brushBttn_clicked()
@@ -342,6 +627,13 @@ void MainWindow::on_ellipseBttn_clicked()
     currTool = Tool::ELLIPSE;
 }
 
+void MainWindow::on_lineBttn_clicked()
+{
+    updateToolBorderSelection(Tool::LINE);
+    currTool = Tool::LINE;
+    hasLineEnd = false;
+}
+
 void MainWindow::on_paintBttn_clicked()
 {
     updateToolBorderSelection(Tool::PAINT);
@@ -378,21 +670,20 @@ void MainWindow::resizeWindow(unsigned int size)
 {
     // Send update to Model, Display
     model->createImage(size);
-    displays->rebuildFrameButtonsFromModel();
+}
 
+void MainWindow::refreshCanvasSize()
+{
     // Update Canvas
     createCanvas();
     createBg();
-    updateView();
+    updateView(QRect(0, 0, model->getCanvasSize(), model->getCanvasSize()));
 }
 
 void MainWindow::createCanvas()
 {
-    // Add the pixmap to the scene
-    scene->addPixmap(QPixmap::fromImage(*model->getImage()));
-
-    // Ensure the scenes area matches the pixmap
-    scene->setSceneRect(scene->itemsBoundingRect());
+    // Ensure the scenes area matches the canvas
+    scene->setSceneRect(0, 0, model->getCanvasSize(), model->getCanvasSize());
 
     // Get user canvas size
     double canvasSize = 725.0 / model->getCanvasSize();
@@ -440,6 +731,7 @@ void MainWindow::createBg()
         }
     }
     background = QPixmap::fromImage(bgImage);
+    backgroundItem->setPixmap(background);
 }
 
 void MainWindow::updateToolBorderSelection(Tool newTool)
@@ -451,6 +743,7 @@ void MainWindow::updateToolBorderSelection(Tool newTool)
     ui->paintBttn->setStyleSheet("");
     ui->rectangleBttn->setStyleSheet("");
     ui->ellipseBttn->setStyleSheet("");
+    ui->lineBttn->setStyleSheet("");
 
     // Set border of selected tool
     switch (newTool)
@@ -473,6 +766,9 @@ void MainWindow::updateToolBorderSelection(Tool newTool)
     case Tool::RECTANGLE:
         ui->rectangleBttn->setStyleSheet("border: 2px solid blue");
         break;
+    case Tool::LINE:
+        ui->lineBttn->setStyleSheet("border: 2px solid blue");
+        break;
     }
 }
 
@@ -11,6 +11,8 @@ using std::string;
 #include <QtWidgets/qscrollarea.h>
 #include <QtWidgets/qslider.h>
 #include <QGridLayout>
+#include <QLabel>
+#include <QProgressBar>
 
 // For all the canvas here
 #include <QPixmap>
@@ -33,6 +35,7 @@ using std::string;
 #include "models.h"
 #include "displays.h"
 #include "palette.h"
+#include "canvaslayer.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui
@@ -82,7 +85,9 @@ public:
         // Rectangle tool for drawing rectangles.
         RECTANGLE,
         // Ellipse tool for drawing ellipses.
-        ELLIPSE
+        ELLIPSE,
+        // Line tool for drawing straight lines and polylines.
+        LINE
     };
     Q_ENUM(Tool)
 
@@ -116,10 +121,29 @@ private:
     QPainter *qpainter;
     // Scene for handling graphics items.
     QGraphicsScene *scene;
+    // Checkerboard shown behind the canvas.
+    QGraphicsPixmapItem *backgroundItem;
+    // The current frame, only re-uploaded where it changes.
+    CanvasLayer *canvasLayer;
+    // The shape preview drawn above the canvas.
+    CanvasLayer *previewLayer;
     // Flag indicating if the user is drawing.
     bool drawing = false;
-    // Current pixel position for drawing.
-    QPointF currPixel;
+    // Canvas pixel the pointer was over at the last press or move, strokes continue from here.
+    QPoint currPixel;
+    // End of the last line drawn with the line tool, Shift+click continues a polyline from it.
+    QPoint lineEnd;
+    bool hasLineEnd = false;
+    // Status bar progress and cancel button of a background save or load, hidden while none runs.
+    QProgressBar *projectProgress;
+    QPushButton *projectCancelButton;
+    // Status bar text showing how much memory the frames use.
+    QLabel *frameMemoryLabel;
+
+    /**
+     * @brief Adds the save and load progress widgets to the status bar and connects them to the model.
+     */
+    void initializeProjectProgress();
 
     /**
      * @brief Initializes buttons with appropriate styles.
@@ -131,6 +155,11 @@ private:
      */
     void createCanvas();
 
+    /**
+     * @brief Connects the mirror and rotate buttons and gives them right-click menus with every transform.
+     */
+    void initializeTransformButtons();
+
     /**
      * Switches the border fo the tool selector to the new tool
      * @param newTool The new tool to be selected
@@ -146,14 +175,21 @@ private slots:
     // Canvas
     /**
      * @brief Updates the view with the latest changes.
+     * @param dirty The area of the canvas that changed.
      */
-    void updateView();
+    void updateView(const QRect &dirty);
 
     /**
      * @brief Creates a background for the canvas.
      */
     void createBg();
 
+    /**
+     * @brief Applies the chosen brush shape, asking for a stamp image when the custom shape is picked.
+     * @param index The index of the shape in the brush shape box.
+     */
+    void brushShapeChanged(int index);
+
     // Tool button click handlers
 
     /**
@@ -181,6 +217,11 @@ private slots:
      */
     void on_ellipseBttn_clicked();
 
+    /**
+     * @brief on_lineBttn_clicked Select line
+     */
+    void on_lineBttn_clicked();
+
     /**
      * @brief on_brushBttn_clicked Select paintbucket
      */
@@ -196,6 +237,26 @@ private slots:
      */
     void resizeWindow(unsigned int size);
 
+    /**
+     * @brief Fits the scene, background and layers to the model's canvas size after the frames were replaced.
+     */
+    void refreshCanvasSize();
+
+    /**
+     * @brief Shows the memory the frames use and how much duplicated frames share in the status bar.
+     */
+    void updateFrameMemoryLabel();
+
+    /**
+     * @brief Finds identical frames, lets them share their pixels and reports which frames they were.
+     */
+    void findDuplicateFrames();
+
+    /**
+     * @brief Asks for the most memory the frames may use and applies it.
+     */
+    void setFrameMemoryBudget();
+
 protected:
     /**
      * @brief Handles mouse press events on the canvas.
@@ -7,122 +7,440 @@
  */
 
 #include "models.h"
+#include "blend.h"
+#include "pixelview.h"
+#include "rasterizer.h"
 #include "qpainter.h"
 #include "qpixmap.h"
 #include "QTimer"
-#include "QJsonObject"
-#include "QJsonArray"
 #include "QFileDialog"
-#include "QJsonDocument"
 #include "QMessageBox"
+#include <QDir>
+#include <QFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <algorithm>
+
+namespace
+{
+    // How often changes are appended to the autosave journal
+    const int AUTOSAVE_INTERVAL_MS = 30000;
+
+    // The journal is compacted once it outgrows both this and twice the raw size of the frames
+    const qint64 COMPACT_MIN_BYTES = 4 * 1024 * 1024;
+
+    // Settings key naming the journal of the running session, it is removed on a clean exit
+    const char JOURNAL_KEY[] = "autosave/journal";
+
+    // Settings key of the frame memory budget in bytes
+    const char FRAME_BUDGET_KEY[] = "memory/frameBudget";
+
+    // Frames used this recently are never packed, so playing a short loop or flipping between frames stays smooth
+    const size_t RECENT_FRAMES = 8;
+
+    // Paged frames this close to the current frame or ahead of the animation are read in before they are needed
+    const int PREFETCH_FRAMES = 2;
+
+    // Frames transformed together when every frame is, enough to keep each worker thread busy
+    const size_t TRANSFORM_BATCH = 32;
+
+    // Units of the animation clock
+    const qint64 NSECS_PER_SECOND = 1000000000;
+    const qint64 NSECS_PER_MSEC = 1000000;
+}
 
 Model::Model(QObject *parent) : QObject(parent)
 {
     animationTimer = new QTimer(this);
+    // The timer is only a wake-up call, the animation clock decides which frame is shown
+    animationTimer->setSingleShot(true);
+    animationTimer->setTimerType(Qt::PreciseTimer);
     // Connect the timer's timeout signal to the updateAnimationFrame slot
     connect(animationTimer, &QTimer::timeout, this, &Model::updateAnimationFrame);
+
+    // Canvas updates are gathered and sent once control returns to the event loop
+    canvasUpdateTimer = new QTimer(this);
+    canvasUpdateTimer->setSingleShot(true);
+    canvasUpdateTimer->setInterval(0);
+    connect(canvasUpdateTimer, &QTimer::timeout, this, &Model::flushCanvasUpdate);
+
+    // Project files are read and written on a worker thread, results come back through these signals
+    projectIO = new ProjectIO(this);
+    connect(projectIO, &ProjectIO::started, this, &Model::projectTaskStarted);
+    connect(projectIO, &ProjectIO::progressChanged, this, &Model::projectTaskProgress);
+    connect(projectIO, &ProjectIO::saveFinished, this, &Model::projectSaved);
+    connect(projectIO, &ProjectIO::loadFinished, this, &Model::projectLoaded);
+
+    autosaveTimer = new QTimer(this);
+    connect(autosaveTimer, &QTimer::timeout, this, &Model::autosave);
+    autosaveTimer->start(AUTOSAVE_INTERVAL_MS);
+    frameMemoryBudget = QSettings().value(FRAME_BUDGET_KEY, 0).toLongLong();
     createImage(32); // Initialize a new canvas of size 32x32
 }
 
 Model::~Model()
 {
     // Clean up allocated images to avoid memory leaks
-    delete image;
     delete shapePreview;
-    delete tracker;
+
+    // A save still running is waited for instead of cancelled, a failed one leaves its edits unsaved
+    if (projectIO->isSaving() && !projectIO->finishSave() && !pendingSavePath.isEmpty())
+        lastSaveFailed = true;
+
+    // Closing normally leaves nothing to recover, unless the last save did not reach the disk. Then the journal
+    // catches up with the latest edits and stays for the next start to offer
+    if (lastSaveFailed)
+    {
+        autosave();
+        return;
+    }
+    journal.remove();
+    QSettings().remove(JOURNAL_KEY);
 }
 
 void Model::createImage(int inputSize)
 {
     size = inputSize;
 
-    image = new QImage(size, size, QImage::Format_ARGB32);
-    clearCanvas();
-
-    // Reset frames and add the first frame (the new image)
+    // Reset frames and add the first frame (the new blank canvas)
     frames.clear();
-    frames.push_back(*image);
+    frames.emplace_back(inputSize);
     currentFrameIndex = 0;
+    loadCanvas();
+    resetFrameStates();
     animationIndex = 0;
 
-    // Restart the animation timer if active
-    if (animationTimer && animationTimer->isActive())
-        animationTimer->stop();
+    // Restart the animation from the first frame
     animationPlaying = true;
-    animationTimer->start(1000 / animationFps);
-    updateAnimationFrame();
+    restartAnimationClock();
+
+    resetScratchImages();
+    markDirty(canvasRect());
+
+    // A save still running was of the old canvas, it must not become the new canvas's base
+    projectPath.clear();
+    pendingSavePath.clear();
+    startJournal(QString(), frameIds());
+    emit framesReloaded();
+}
 
+void Model::replaceFrames(std::vector<TiledFrame> newFrames)
+{
+    Q_ASSERT(!newFrames.empty());
+
+    size = newFrames.front().size();
+    frames = std::move(newFrames);
+    currentFrameIndex = 0;
+    animationIndex = 0;
+    loadCanvas();
+    resetFrameStates();
+    useFrame(currentFrameIndex);
+    enforceFrameBudget();
+
+    resetScratchImages();
+    markDirty(canvasRect());
+    emit framesReloaded();
+}
+
+void Model::resetScratchImages()
+{
     // Initialize additional images used for tracking and shape previews
-    tracker = new QImage(size, size, QImage::Format_ARGB32);
+    delete shapePreview;
+    tracker.resize(size, size);
     shapePreview = new QImage(size, size, QImage::Format_ARGB32);
+    shapePreview->fill(0);
+    shapePreviewRect = QRect();
     clearNonCanvas();
 }
 
 QImage *Model::getImage()
 {
-    return image;
+    return &canvas;
+}
+
+void Model::storeCanvas()
+{
+    frames[currentFrameIndex].store(canvas, canvasChanged);
+    canvasChanged = QRect();
+}
+
+void Model::loadCanvas()
+{
+    canvas = frames[currentFrameIndex].toImage();
+    canvasChanged = QRect();
+}
+
+QImage Model::frameImage(size_t index) const
+{
+    return index == currentFrameIndex ? canvas : frames[index].toImage();
+}
+
+std::vector<std::vector<size_t>> Model::findDuplicateFrames()
+{
+    storeCanvas();
+    TiledFrame::shareTiles(frames);
+    return TiledFrame::findIdentical(frames);
+}
+
+qint64 Model::getFrameMemoryBudget() const
+{
+    return frameMemoryBudget;
+}
+
+void Model::setFrameMemoryBudget(qint64 bytes)
+{
+    frameMemoryBudget = std::max<qint64>(bytes, 0);
+    QSettings().setValue(FRAME_BUDGET_KEY, frameMemoryBudget);
+    storeCanvas();
+    enforceFrameBudget();
+}
+
+void Model::useFrame(size_t index)
+{
+    frameStates[index].lastUsed = ++useCounter;
+    frames[index].unpack();
+}
+
+void Model::enforceFrameBudget()
+{
+    if (frameMemoryBudget <= 0)
+        return;
+    qint64 bytes = getFrameMemoryUsage().bytes;
+    if (bytes <= frameMemoryBudget)
+        return;
+
+    // Frames used longest ago are packed first, the current frame and the most recently used ones are kept
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        if (i != currentFrameIndex && !frames[i].isPaged())
+            candidates.push_back(i);
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](size_t a, size_t b)
+              { return frameStates[a].lastUsed < frameStates[b].lastUsed; });
+    candidates.resize(candidates.size() - std::min(candidates.size(), RECENT_FRAMES));
+
+    for (size_t index : candidates)
+    {
+        if (bytes <= frameMemoryBudget)
+            break;
+        bytes -= frames[index].pack();
+    }
+
+    // When packing is not enough the packed frames move to the scratch file, again oldest first
+    for (size_t index : candidates)
+    {
+        if (bytes <= frameMemoryBudget)
+            break;
+        bytes -= frames[index].pageOut(pager);
+    }
+}
+
+void Model::prefetchFrames(int first, int last, bool wrap)
+{
+    std::vector<std::shared_ptr<const FramePager::Page>> pages;
+    int count = static_cast<int>(frames.size());
+    for (int i = first; i <= last; i++)
+    {
+        int index = wrap ? (i % count + count) % count : i;
+        if (index < 0 || index >= count)
+            continue;
+        if (std::shared_ptr<const FramePager::Page> page = frames[index].page())
+            pages.push_back(std::move(page));
+    }
+    pager.prefetch(std::move(pages));
+}
+
+TiledFrame::Usage Model::getFrameMemoryUsage() const
+{
+    // The current frame's latest edits are only in the canvas, which is counted as one more whole frame
+    TiledFrame::Usage usage = TiledFrame::usage(frames);
+    usage.bytes += canvas.sizeInBytes();
+    return usage;
 }
 
 void Model::clearCanvas()
 {
     // Clear the main canvas (set all pixels to 0)
-    image->fill(0);
-    if (frames.size() > 0)
-        frames[currentFrameIndex] = *image;
-    emit canvasUpdated();
+    canvas.fill(0);
+    touchFrame(currentFrameIndex, canvasRect());
+    markDirty(canvasRect());
 }
 
 void Model::clearNonCanvas()
 {
-    // Clear auxiliary images used for tracker and shape preview
-    tracker->fill(0);
-    shapePreview->fill(0);
-    emit canvasUpdated();
+    // Forget the finished stroke and clear what the shape preview covered
+    tracker.clear();
+    clearShapePreview();
+
+    // Only the area the last shape covered is visibly changed
+    if (!shapePreviewRect.isEmpty())
+        markDirty(shapePreviewRect);
+    shapePreviewRect = QRect();
 }
 
-void Model::addFrame()
+void Model::beginEdit()
+{
+    editDepth++;
+}
+
+void Model::endEdit()
+{
+    if (editDepth > 0)
+        editDepth--;
+    if (editDepth == 0 && !pendingDirty.isEmpty())
+        canvasUpdateTimer->start();
+}
+
+void Model::markDirty(const QRect &rect)
 {
-    QImage newFrame(size, size, QImage::Format_ARGB32);
-    newFrame.fill(0);
+    pendingDirty |= rect;
+    // Inside a transaction the update waits for endEdit
+    if (editDepth == 0 && !canvasUpdateTimer->isActive())
+        canvasUpdateTimer->start();
+}
 
+void Model::flushCanvasUpdate()
+{
+    if (editDepth > 0 || pendingDirty.isEmpty())
+        return;
+
+    QRect dirty = pendingDirty;
+    pendingDirty = QRect();
+    emit canvasUpdated(dirty);
+}
+
+QRect Model::canvasRect() const
+{
+    return QRect(0, 0, size, size);
+}
+
+void Model::addFrame()
+{
     // Insert the new frame right after the current frame
-    auto pos = frames.begin() + currentFrameIndex + 1;
-    frames.insert(pos, newFrame);
-    selectFrame(++currentFrameIndex);
+    insertBlankFrames(currentFrameIndex + 1, 1);
 }
 
 void Model::duplicateFrame()
 {
-    // Create a copy of the current frame and insert it as a new frame
-    QImage newFrame = frames[currentFrameIndex].copy();
-
-    auto pos = frames.begin() + currentFrameIndex + 1;
-    frames.insert(pos, newFrame);
-    selectFrame(++currentFrameIndex);
+    duplicateFrames(currentFrameIndex, 1);
 }
 
 void Model::removeFrame(unsigned int index)
 {
-    // Ensure at least one frame remains in the project
-    if (frames.size() <= 1 || index >= frames.size())
-    {
-        clearCanvas();
-        frames[0] = *image;
+    removeFrames(index, 1);
+}
+
+void Model::insertFrames(size_t index, std::vector<TiledFrame> newFrames, const QRect &dirty)
+{
+    size_t count = newFrames.size();
+    frames.insert(frames.begin() + index, std::make_move_iterator(newFrames.begin()), std::make_move_iterator(newFrames.end()));
+    std::vector<FrameState> newStates;
+    newStates.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        newStates.push_back(newFrameState(dirty));
+    frameStates.insert(frameStates.begin() + index, newStates.begin(), newStates.end());
+
+    // Frames at or after the insertion point moved back
+    if (currentFrameIndex >= index)
+        currentFrameIndex += count;
+    if (animationIndex >= int(index))
+        animationIndex += int(count);
+    emit framesInserted(int(index), int(count));
+}
+
+void Model::insertBlankFrames(size_t index, size_t count)
+{
+    if (count == 0 || index > frames.size())
         return;
-    }
 
-    frames.erase(frames.begin() + index);
+    // Blank frames hold no tiles, so any number of them costs next to nothing
+    storeCanvas();
+    insertFrames(index, std::vector<TiledFrame>(count, TiledFrame(int(size))), QRect());
+    selectFrame(index);
+}
 
-    // Adjust current frame index after deletion
-    if (currentFrameIndex > 0)
-        currentFrameIndex--;
-    else
-        currentFrameIndex = 0;
+void Model::duplicateFrames(size_t first, size_t count)
+{
+    if (count == 0 || first + count > frames.size())
+        return;
+
+    // The copies go right after the range and share every tile with the originals until one of them is edited
+    storeCanvas();
+    std::vector<TiledFrame> copies(frames.begin() + first, frames.begin() + first + count);
+    insertFrames(first + count, std::move(copies), canvasRect());
+    selectFrame(first + count);
+}
+
+void Model::removeFrames(size_t first, size_t count)
+{
+    if (count == 0 || first + count > frames.size())
+        return;
 
-    *image = frames[currentFrameIndex];
+    // At least one frame remains in the project, removing every frame keeps the first one and clears it
+    storeCanvas();
+    bool clearLast = count >= frames.size();
+    if (clearLast)
+    {
+        first = 1;
+        count = frames.size() - 1;
+    }
+
+    if (count > 0)
+    {
+        frames.erase(frames.begin() + first, frames.begin() + first + count);
+        frameStates.erase(frameStates.begin() + first, frameStates.begin() + first + count);
+        touchLayout();
+
+        // A removed current frame gives way to the frame before the range
+        if (currentFrameIndex >= first + count)
+            currentFrameIndex -= count;
+        else if (currentFrameIndex >= first)
+            currentFrameIndex = first > 0 ? first - 1 : 0;
+        // The animation goes on with the frame after the range, wrapping around if there is none
+        if (animationIndex >= int(first + count))
+            animationIndex -= int(count);
+        else if (animationIndex >= int(first))
+            animationIndex = int(first);
+        loadCanvas();
+        emit framesRemoved(int(first), int(count));
+    }
 
+    if (clearLast)
+        clearCanvas();
     emit frameModified(currentFrameIndex);
-    emit canvasUpdated();
+    emit requestNewSelectedFrameIndex(currentFrameIndex);
+    markDirty(canvasRect());
+}
+
+void Model::reverseFrames(size_t first, size_t count)
+{
+    if (count < 2 || first + count > frames.size())
+        return;
+
+    // Only the tile lists change places, the canvas follows the current frame to its new index
+    std::reverse(frames.begin() + first, frames.begin() + first + count);
+    std::reverse(frameStates.begin() + first, frameStates.begin() + first + count);
+    auto reversedIndex = [first, count](size_t index)
+    { return index >= first && index < first + count ? 2 * first + count - 1 - index : index; };
+    currentFrameIndex = reversedIndex(currentFrameIndex);
+    animationIndex = int(reversedIndex(size_t(animationIndex)));
+    touchLayout();
+
+    emit framesReversed(int(first), int(count));
+    emit requestNewSelectedFrameIndex(currentFrameIndex);
+}
+
+void Model::addPingPongFrames(size_t first, size_t count)
+{
+    // A B C D plays back as A B C D C B, the ends are not repeated so the loop has no held frames
+    if (count < 3 || first + count > frames.size())
+        return;
+
+    storeCanvas();
+    std::vector<TiledFrame> returning(frames.rbegin() + (frames.size() - first - count) + 1,
+                                      frames.rbegin() + (frames.size() - first) - 1);
+    insertFrames(first + count, std::move(returning), canvasRect());
 }
 
 void Model::selectFrame(unsigned int index)
@@ -130,11 +448,16 @@ void Model::selectFrame(unsigned int index)
     // Change the current frame if the index is valid
     if (index < frames.size())
     {
-        *image = frames[index];
+        // Only the tiles the edits touched are written back before the new frame is unpacked
+        storeCanvas();
         currentFrameIndex = index;
+        useFrame(index);
+        enforceFrameBudget();
+        prefetchFrames(int(index) - PREFETCH_FRAMES, int(index) + PREFETCH_FRAMES, false);
+        loadCanvas();
         emit frameModified(index);
         emit requestNewSelectedFrameIndex(index);
-        emit canvasUpdated();
+        markDirty(canvasRect());
     }
 }
 
@@ -143,19 +466,40 @@ unsigned int Model::getCurrentFrameIndex() const
     return currentFrameIndex;
 }
 
-QPixmap Model::getFrameThumbnail(int index, int width, int height) const
+size_t Model::getFrameCount() const
 {
-    // Generate a scaled thumbnail from the frame, if valid
-    if (index < static_cast<int>(frames.size()) && index >= 0)
-    {
-        return QPixmap::fromImage(frames[index]).scaled(width, height, Qt::KeepAspectRatio, Qt::FastTransformation);
-    }
-    return QPixmap();
+    return frames.size();
+}
+
+quint32 Model::getFrameId(size_t index) const
+{
+    return frameStates[index].id;
 }
 
-const std::vector<QImage> &Model::getFrames() const
+quint64 Model::getFrameGeneration(size_t index) const
 {
-    return frames;
+    return frameStates[index].generation;
+}
+
+int Model::findFrame(quint32 id) const
+{
+    auto state = std::find_if(frameStates.begin(), frameStates.end(), [id](const FrameState &state)
+                              { return state.id == id; });
+    return state == frameStates.end() ? -1 : int(state - frameStates.begin());
+}
+
+TiledFrame Model::getFrameSnapshot(size_t index)
+{
+    // The canvas is ahead of its frame until stored, storing only copies the tiles that changed
+    if (index == currentFrameIndex)
+        storeCanvas();
+    return frames[index];
+}
+
+TiledFrame Model::getStoredFrame(size_t index) const
+{
+    Q_ASSERT(index != currentFrameIndex);
+    return frames[index];
 }
 
 void Model::shiftFrameUp()
@@ -170,76 +514,113 @@ void Model::shiftFrameDown()
 
 void Model::swapFrame(bool swapUp)
 {
-    // Determine the offset: -1 for up, +1 for down
-    int offset;
+    // Moving up puts the frame in front of the one above, moving down puts it in front of the one after next
     if (swapUp)
-        offset = -1;
+        moveFrames(currentFrameIndex, 1, currentFrameIndex - 1);
     else
-        offset = 1;
+        moveFrames(currentFrameIndex, 1, currentFrameIndex + 2);
+}
 
-    // Save references to the selected and target frames for swapping
-    QImage &selectedImage = frames[currentFrameIndex];
-    QImage &swappingImage = frames[currentFrameIndex + offset];
+void Model::moveFrame(size_t from, size_t to)
+{
+    moveFrames(from, 1, to > from ? to + 1 : to);
+}
 
-    // Swap the contents using a temporary image copy
-    QImage tempImage = selectedImage;
-    selectedImage = swappingImage.copy();
-    swappingImage = tempImage.copy();
+void Model::moveFrames(size_t first, size_t count, size_t destination)
+{
+    size_t end = first + count;
+    if (count == 0 || end > frames.size() || destination > frames.size() || (destination >= first && destination <= end))
+        return;
 
-    // Update the current frame index to reflect the swap
-    currentFrameIndex += offset;
+    // A move is a rotation of the part of the list between the run and the destination
+    auto rotate = [first, end, destination](auto &list)
+    {
+        if (destination < first)
+            std::rotate(list.begin() + destination, list.begin() + first, list.begin() + end);
+        else
+            std::rotate(list.begin() + first, list.begin() + end, list.begin() + destination);
+    };
+    rotate(frames);
+    rotate(frameStates);
 
-    *image = frames[currentFrameIndex].copy();
-    emit frameModified(currentFrameIndex);
-    emit canvasUpdated();
+    auto movedIndex = [first, end, count, destination](size_t index)
+    {
+        if (index >= first && index < end)
+            return (destination < first ? destination : destination - count) + (index - first);
+        if (destination < first && index >= destination && index < first)
+            return index + count;
+        if (destination > end && index >= end && index < destination)
+            return index - count;
+        return index;
+    };
+    // The canvas belongs to the current frame, which only changes its index
+    currentFrameIndex = movedIndex(currentFrameIndex);
+    animationIndex = int(movedIndex(size_t(animationIndex)));
+    touchLayout();
+
+    emit framesMoved(int(first), int(count), int(destination));
 }
 
 void Model::mirrorFrame()
 {
-    QImage temp = image->copy();
-    // Mirror the image horizontally by swapping pixels from left to right
-    for (int i = 0; i < size; i++)
-    {
-        for (int j = 0; j < size; j++)
-        {
-            // The pixel from the mirrored horizontal position is used
-            image->setPixelColor(i, j, temp.pixelColor(size - 1 - i, j));
-        }
-    }
-    // Update the frame if the index is valid
-    if (currentFrameIndex < frames.size())
-    {
-        frames[currentFrameIndex] = *image;
-    }
-    emit canvasUpdated();
+    transformFrames(FrameTransform::Operation::FLIP_HORIZONTAL, false);
 }
 
 void Model::rotateFrame()
 {
-    QImage temp = image->copy();
-    // Rotate the image 90 degrees clockwise by remapping pixel positions
-    for (int i = 0; i < size; i++)
+    transformFrames(FrameTransform::Operation::ROTATE_90, false);
+}
+
+void Model::transformFrames(FrameTransform::Operation operation, bool allFrames)
+{
+    if (allFrames)
     {
-        for (int j = 0; j < size; j++)
+        // Frames are unpacked and transformed a batch at a time, each batch is tiled again and the budget packs
+        // frames before the next batch is unpacked, so only one batch of whole images is ever in memory
+        storeCanvas();
+        std::vector<QImage> images;
+        std::vector<TiledFrame> batch;
+        for (size_t first = 0; first < frames.size(); first += TRANSFORM_BATCH)
         {
-            // New position comes from transposing and flipping the indices
-            image->setPixelColor(i, j, temp.pixelColor(j, size - 1 - i));
+            size_t count = std::min(TRANSFORM_BATCH, frames.size() - first);
+            images.clear();
+            for (size_t i = first; i < first + count; i++)
+                images.push_back(frames[i].toImage());
+            FrameTransform::applyToAll(images, operation);
+
+            batch.clear();
+            for (QImage &image : images)
+            {
+                batch.emplace_back(image);
+                image = QImage();
+            }
+            TiledFrame::shareTiles(batch);
+            for (size_t i = 0; i < count; i++)
+            {
+                frames[first + i] = std::move(batch[i]);
+                touchFrame(first + i, canvasRect());
+            }
+            enforceFrameBudget();
         }
+        TiledFrame::shareTiles(frames);
+        enforceFrameBudget();
+        loadCanvas();
+        emit allFramesModified();
     }
-    // Update the frame storage with the rotated image
-    if (currentFrameIndex < frames.size())
+    else
     {
-        frames[currentFrameIndex] = *image;
+        FrameTransform::apply(canvas, operation);
+        touchFrame(currentFrameIndex, canvasRect());
     }
-    emit canvasUpdated();
+    markDirty(canvasRect());
 }
 
 void Model::sliderValueChanged(int value)
 {
     animationFps = value;
     emit updateFpsSliderIO(value);
-    if (animationTimer->isActive())
-        animationTimer->setInterval(1000 / animationFps); // Update timer interval based on FPS
+    if (animationPlaying)
+        restartAnimationClock(); // Frame times at the old speed no longer apply
 }
 
 void Model::toggleAnimation()
@@ -254,62 +635,139 @@ void Model::toggleAnimation()
     else
     {
         animationPlaying = true;
-        animationTimer->start(1000 / animationFps);
+        restartAnimationClock();
         emit togglePlayPauseButtonIcon(true);
     }
 }
 
 void Model::updateAnimationFrame()
 {
-    // Do nothing if the animation is paused
-    if (!animationPlaying)
+    // Do nothing if the animation is paused, a speed of zero frames per second never shows the next frame
+    if (!animationPlaying || animationFps <= 0)
+    {
+        animationTimer->stop();
         return;
+    }
 
-    emit updateAnimationIcon(animationIndex);
+    // A frame is due at every whole frame time on the clock. A late timer skips the frames it missed instead of
+    // playing them late, so the animation never falls behind
+    qint64 elapsed = animationClock.nsecsElapsed();
+    qint64 tick = elapsed * animationFps / NSECS_PER_SECOND;
+    if (tick != animationTick)
+    {
+        qint64 steps = animationTick < 0 ? 0 : tick - animationTick;
+        animationIndex = int((animationIndex + steps) % qint64(frames.size()));
+        animationTick = tick;
 
-    // Cycle through frames; if at the last frame, restart at the beginning
-    if (animationIndex >= static_cast<int>(frames.size()) - 1)
-        animationIndex = 0;
-    else
-        animationIndex++;
+        // The preview is drawn from a snapshot, so playback leaves packed frames packed and does not count as a use.
+        // Paged frames coming up are still read in, in case their previews have to be made again
+        prefetchFrames(animationIndex + 1, animationIndex + PREFETCH_FRAMES, true);
+
+        emit updateAnimationIcon(animationIndex);
+    }
+
+    // Wake up when the next frame is due, rounded up so the timer never fires before it
+    qint64 next = (tick + 1) * NSECS_PER_SECOND / animationFps;
+    animationTimer->start(int((next - elapsed + NSECS_PER_MSEC - 1) / NSECS_PER_MSEC));
 }
 
-void Model::setPixel(int x, int y, QColor userColor)
+void Model::restartAnimationClock()
 {
-    // Retrieve the current color at (x, y) into selectColor
-    getPixel(x, y);
+    animationClock.start();
+    animationTick = -1;
+    updateAnimationFrame();
+}
 
-    // If the current pixel is transparent (all channels 0), simply set the user color
-    if (selectColor.red() == 0 && selectColor.green() == 0 && selectColor.blue() == 0 && selectColor.alpha() == 0)
-    {
-        image->setPixelColor(x, y, userColor);
-    }
-    else
+void Model::strokeLine(int x0, int y0, int x1, int y1, QColor userColor)
+{
+    PixelView frame(canvas);
+    QRgb color = userColor.rgba();
+    QRect bounds = canvasRect();
+    QRect dirty;
+
+    // Stamp the brush at every pixel of the line
+    Rasterizer::line(x0, y0, x1, y1, [&](int centerX, int centerY)
+                     {
+                         const Brush::Mask &mask = brush.mask(centerX, centerY);
+                         QRect stamped = mask.bounds.translated(centerX, centerY) & bounds;
+                         if (stamped.isEmpty())
+                             return;
+
+                         for (const Brush::Run &run : mask.runs)
+                         {
+                             // Clip the run to the canvas
+                             int y = centerY + run.dy;
+                             int left = std::max(centerX + run.dx, 0);
+                             int right = std::min(centerX + run.dx + run.length, frame.width());
+                             if (y < 0 || y >= frame.height() || left >= right)
+                                 continue;
+
+                             // Blend each part of the run this stroke has not painted yet
+                             QRgb *row = frame.row(y);
+                             tracker.visitSpan(y, left, right, [&](int start, int end)
+                                               { Blend::solidSpan(row + start, color, end - start); });
+                         }
+                         dirty |= stamped;
+                     });
+
+    if (!dirty.isEmpty())
     {
-        // Otherwise, blend the colors additively
-        QColor blendedColor = blendAdditive(userColor, selectColor);
-        image->setPixelColor(x, y, blendedColor); // Apply blended color
+        touchFrame(currentFrameIndex, dirty);
+        markDirty(dirty);
     }
+}
 
-    // Update the current frame in the frames vector
-    if (currentFrameIndex < frames.size())
+void Model::eraseLine(int x0, int y0, int x1, int y1)
+{
+    PixelView frame(canvas);
+    const Brush::Mask &mask = brush.solidMask();
+    QRect bounds = canvasRect();
+    QRect dirty;
+
+    Rasterizer::line(x0, y0, x1, y1, [&](int centerX, int centerY)
+                     {
+                         QRect stamped = mask.bounds.translated(centerX, centerY) & bounds;
+                         if (stamped.isEmpty())
+                             return;
+
+                         for (const Brush::Run &run : mask.runs)
+                         {
+                             int y = centerY + run.dy;
+                             int left = std::max(centerX + run.dx, 0);
+                             int right = std::min(centerX + run.dx + run.length, frame.width());
+                             if (y < 0 || y >= frame.height() || left >= right)
+                                 continue;
+
+                             std::fill(frame.row(y) + left, frame.row(y) + right, 0u);
+                         }
+                         dirty |= stamped;
+                     });
+
+    if (!dirty.isEmpty())
     {
-        frames[currentFrameIndex] = *image;
+        touchFrame(currentFrameIndex, dirty);
+        markDirty(dirty);
     }
+}
 
-    emit canvasUpdated();
-    // Also update the tracker image with the user color
-    tracker->setPixelColor(x, y, userColor);
+void Model::setBrushSize(int size)
+{
+    brush.setSize(size);
 }
 
-void Model::setPixelTracker(int x, int y, QColor userColor)
+void Model::setBrushShape(Brush::Shape shape)
 {
-    // Only set the pixel if the tracker doesn't already have the desired color
-    if (tracker->pixelColor(x, y) == userColor)
-    {
-        return;
-    }
-    setPixel(x, y, userColor);
+    brush.setShape(shape);
+}
+
+void Model::setBrushDither(Brush::Dither dither)
+{
+    brush.setDither(dither);
+}
+
+void Model::setCustomBrushStamp(const QImage &stamp)
+{
+    brush.setCustomStamp(stamp);
 }
 
 QImage *Model::getShapePreview()
@@ -326,108 +784,122 @@ void Model::shapeStart(int x, int y)
 
 void Model::rectangleShape(int x, int y, QColor userColor)
 {
-    // Clear previous shape preview content
-    shapePreview->fill(QColor(0, 0, 0, 0));
-    QPainter painter(shapePreview);
-    QPen pen(userColor);
-    pen.setWidth(1);
-    painter.setPen(pen);
+    clearShapePreview();
+    QRgb color = userColor.rgba();
     // Draw a rectangle defined by the start point and current mouse position
-    painter.drawRect(std::min(shapeStartX, x),
-                     std::min(shapeStartY, y),
-                     qAbs(shapeStartX - x),
-                     qAbs(shapeStartY - y));
-    painter.end();
+    Rasterizer::rectSpans(shapeStartX, shapeStartY, x, y, shapeFilled, [&](int row, int left, int right)
+                          { previewSpan(row, left, right, color); });
+    showShapePreview(QRect(QPoint(std::min(shapeStartX, x), std::min(shapeStartY, y)),
+                           QPoint(std::max(shapeStartX, x), std::max(shapeStartY, y))));
 }
 
 void Model::ellipseShape(int x, int y, QColor userColor)
 {
-    // Clear previous shape preview content
-    shapePreview->fill(QColor(0, 0, 0, 0));
-    QPainter painter(shapePreview);
-    QPen pen(userColor);
-    pen.setWidth(1);
-    painter.setPen(pen);
-    // Draw an ellipse defined by the start point and current mouse position
-    painter.drawEllipse(std::min(shapeStartX, x),
-                        std::min(shapeStartY, y),
-                        qAbs(shapeStartX - x),
-                        qAbs(shapeStartY - y));
-    painter.end();
+    clearShapePreview();
+    QRgb color = userColor.rgba();
+    // Draw an ellipse inscribed in the box defined by the start point and current mouse position
+    Rasterizer::ellipseSpans(shapeStartX, shapeStartY, x, y, shapeFilled, [&](int row, int left, int right)
+                             { previewSpan(row, left, right, color); });
+    showShapePreview(QRect(QPoint(std::min(shapeStartX, x), std::min(shapeStartY, y)),
+                           QPoint(std::max(shapeStartX, x), std::max(shapeStartY, y))));
+}
+
+void Model::lineShape(int x, int y, QColor userColor)
+{
+    clearShapePreview();
+    QRgb color = userColor.rgba();
+    // Draw a line from the start point to the current mouse position
+    Rasterizer::lineSpans(shapeStartX, shapeStartY, x, y, [&](int row, int left, int right)
+                          { previewSpan(row, left, right, color); });
+    showShapePreview(QRect(QPoint(std::min(shapeStartX, x), std::min(shapeStartY, y)),
+                           QPoint(std::max(shapeStartX, x), std::max(shapeStartY, y))));
 }
 
 void Model::mergeShapePreview()
 {
-    // Merge the shape preview into the main image
-    QPainter painter(image);
-    painter.drawImage(0, 0, *shapePreview);
-    painter.end();
-    if (currentFrameIndex < frames.size())
+    // Only the shape's box can hold preview pixels, blend just that part into the main image
+    QRect area = shapePreviewRect & canvasRect();
+    if (area.isEmpty())
+        return;
+
+    PixelView frame(canvas);
+    ConstPixelView preview(*shapePreview);
+    for (int y = area.top(); y <= area.bottom(); y++)
     {
-        frames[currentFrameIndex] = *image;
+        Blend::span(frame.row(y) + area.left(), preview.row(y) + area.left(), area.width());
     }
-    emit canvasUpdated();
+    touchFrame(currentFrameIndex, area);
+    markDirty(area);
 }
 
-void Model::paintBucket(int x, int y, QColor userColor)
+void Model::setShapeFilled(bool filled)
 {
-    // Get the color at the starting pixel (the region to be filled)
-    getPixel(x, y);
-    QColor colorToReplace = selectColor;
-    // If the target color is the same as the user-selected color, nothing to do
-    if (colorToReplace == userColor)
-    {
+    shapeFilled = filled;
+}
+
+void Model::clearShapePreview()
+{
+    QRect area = shapePreviewRect & canvasRect();
+    if (area.isEmpty())
         return;
-    }
-    // Start recursive flood fill
-    paintBucketRecursive(x, y, userColor, colorToReplace);
-    if (currentFrameIndex < frames.size())
+
+    PixelView preview(*shapePreview);
+    for (int y = area.top(); y <= area.bottom(); y++)
     {
-        frames[currentFrameIndex] = *image;
+        std::fill_n(preview.row(y) + area.left(), area.width(), 0u);
     }
-    emit canvasUpdated();
 }
 
-void Model::paintBucketRecursive(int x, int y, QColor userColor, QColor colorToReplace)
+void Model::previewSpan(int y, int left, int right, QRgb color)
 {
-    // Base conditions for recursion: if (x, y) is out of bounds, return immediately
-    if (x >= size || x < 0 || y >= size || y < 0)
-    {
+    // Clip the span to the canvas
+    left = std::max(left, 0);
+    right = std::min(right, shapePreview->width() - 1);
+    if (y < 0 || y >= shapePreview->height() || left > right)
         return;
-    }
-    // Update selectColor with the color at the current pixel
-    getPixel(x, y);
-    // If the current pixel is not the target color, stop the recursion along this path
-    if (selectColor != colorToReplace)
+
+    QRgb *row = PixelView(*shapePreview).row(y);
+    std::fill(row + left, row + right + 1, color);
+}
+
+void Model::showShapePreview(const QRect &shapeRect)
+{
+    // Repaint where the old shape was and where the new one is
+    markDirty(shapePreviewRect | shapeRect);
+    shapePreviewRect = shapeRect;
+}
+
+void Model::paintBucket(int x, int y, QColor userColor)
+{
+    // Fill the region in one pass over the raw scanlines, then report the change once
+    QRect filled = FloodFill::fill(canvas, x, y, userColor.rgba(), fillOptions);
+    if (filled.isEmpty())
     {
         return;
     }
-    // Set the current pixel to the user-selected color
-    image->setPixelColor(x, y, userColor);
-    emit canvasUpdated();
-    // Recursively call for neighboring pixels (4-connected flood fill)
-    paintBucketRecursive(x + 1, y, userColor, colorToReplace);
-    paintBucketRecursive(x - 1, y, userColor, colorToReplace);
-    paintBucketRecursive(x, y + 1, userColor, colorToReplace);
-    paintBucketRecursive(x, y - 1, userColor, colorToReplace);
+    touchFrame(currentFrameIndex, filled);
+    markDirty(filled);
 }
 
-void Model::erasePixel(int x, int y)
+void Model::setFillTolerance(int tolerance)
 {
-    // Set the pixel at (x, y) to fully transparent
-    image->setPixelColor(x, y, QColor(0, 0, 0, 0));
+    fillOptions.tolerance = qBound(0, tolerance, 255);
+}
 
-    if (currentFrameIndex < frames.size())
-    {
-        frames[currentFrameIndex] = *image;
-    }
-    emit canvasUpdated();
+void Model::setFillDiagonal(bool enabled)
+{
+    fillOptions.connectivity = enabled ? FloodFill::Connectivity::EIGHT : FloodFill::Connectivity::FOUR;
+}
+
+void Model::setFillGlobal(bool enabled)
+{
+    fillOptions.global = enabled;
 }
 
 void Model::getPixel(int x, int y)
 {
     // Store the color at (x, y) in selectColor
-    selectColor = image->pixelColor(x, y);
+    selectColor = QColor::fromRgba(ConstPixelView(canvas).at(x, y));
 }
 
 int Model::getCanvasSize()
@@ -440,25 +912,6 @@ void Model::setSelectColor(QColor color)
     selectColor = color;
 }
 
-QColor Model::blendAdditive(QColor src, QColor dest)
-{
-    // Extract individual color components from the source and destination colors
-    int redDest = dest.red(), greenDest = dest.green(), blueDest = dest.blue(), alphaDest = dest.alpha();
-    int redSrc = src.red(), greenSrc = src.green(), blueSrc = src.blue(), alphaSrc = src.alpha();
-
-    // Compute the new alpha value using an additive blend formula
-    int alphaOverride = alphaSrc + alphaDest * (255 - alphaSrc) / 255;
-    if (alphaOverride == 0)
-        return QColor(0, 0, 0, 0); // Fully transparent if resulting alpha is zero
-
-    // Compute new RGB values based on the relative contribution of each color
-    int redOverride = (redSrc * alphaSrc + redDest * alphaDest * (255 - alphaSrc) / 255) / alphaOverride;
-    int greenOverride = (greenSrc * alphaSrc + greenDest * alphaDest * (255 - alphaSrc) / 255) / alphaOverride;
-    int blueOverride = (blueSrc * alphaSrc + blueDest * alphaDest * (255 - alphaSrc) / 255) / alphaOverride;
-
-    return QColor(redOverride, greenOverride, blueOverride, alphaOverride);
-}
-
 void Model::addToPalette(QColor color)
 {
     palette.push_back(color);
@@ -474,125 +927,273 @@ QColor Model::getColorFromPalette(unsigned int index)
     return palette.at(index);
 }
 
-void Model::saveProject()
+bool Model::projectIOBusy()
 {
-    QJsonObject json;
-    json["width"] = image->width();
-    json["frameCount"] = int(frames.size());
+    if (!projectIO->isBusy())
+        return false;
+    QMessageBox::information(nullptr, "Busy", "Please wait for the current save or load to finish.");
+    return true;
+}
 
-    QJsonArray frameData;
-    // Iterate over each frame and each pixel to store RGBA values in JSON
-    for (QImage &frame : frames)
+void Model::saveProject()
+{
+    if (projectIOBusy())
     {
-        QJsonArray singleFrame;
-        for (int y = 0; y < image->width(); ++y)
-        {
-            for (int x = 0; x < image->width(); ++x)
-            {
-                QColor color = frame.pixelColor(x, y);
-                // Append each color component in order: red, green, blue, alpha
-                singleFrame.append(color.red());
-                singleFrame.append(color.green());
-                singleFrame.append(color.blue());
-                singleFrame.append(color.alpha());
-            }
-        }
-        frameData.append(singleFrame);
+        return;
     }
-    json["frames"] = frameData;
 
-    // Open a save file dialog to get the file path
+    // Open a save file dialog to get the file path and format
+    QString legacyFilter = "Legacy JSON SSP Files (*.ssp)";
+    QString selectedFilter;
     QString filePath = QFileDialog::getSaveFileName(nullptr,
                                                     "Save Image as SSP",
                                                     "",
-                                                    "SSP Files (.ssp);;All Files (*)");
+                                                    "SSP Files (*.ssp);;" + legacyFilter + ";;All Files (*)",
+                                                    &selectedFilter);
+    if (filePath.isEmpty())
+    {
+        return;
+    }
+
+    // Copying the frame list only shares its tiles, later edits replace tiles instead of changing the snapshot
+    storeCanvas();
+    pendingSavePath = filePath;
+    pendingSaveGeneration = editGeneration;
+    pendingSaveIds = frameIds();
+    projectIO->save(filePath,
+                    frames,
+                    selectedFilter == legacyFilter ? ProjectIO::Format::LEGACY_JSON : ProjectIO::Format::BINARY);
+}
 
-    if (!filePath.isEmpty())
+void Model::projectSaved(bool ok, const QString &error)
+{
+    emit projectTaskFinished();
+    // A save of a canvas that was since replaced says nothing about the frames being edited now
+    lastSaveFailed = !ok && !pendingSavePath.isEmpty();
+    if (!ok)
     {
-        QJsonDocument doc(json);
-        QFile file(filePath);
-        if (file.open(QIODevice::WriteOnly))
-        {
-            file.write(doc.toJson());
-            file.close();
-        }
-        else
-        {
-            QMessageBox::warning(nullptr, "Save Error", "Failed to save SSP file.");
-        }
+        if (!error.isEmpty())
+            QMessageBox::warning(nullptr, "Save Error", "Failed to save SSP file.\n" + error);
+        return;
     }
+    if (pendingSavePath.isEmpty())
+    {
+        return;
+    }
+
+    // The saved file becomes the journal's base, only edits made while it was written still need journaling
+    projectPath = pendingSavePath;
+    baseGeneration = pendingSaveGeneration;
+    autosavedGeneration = pendingSaveGeneration;
+    for (FrameState &state : frameStates)
+        state.dirty = state.generation > pendingSaveGeneration ? canvasRect() : QRect();
+    startJournal(projectPath, pendingSaveIds);
 }
 
 void Model::loadProject()
 {
+    if (projectIOBusy())
+    {
+        return;
+    }
+
     // Open a file dialog to select the project file
     QString filePath = QFileDialog::getOpenFileName(nullptr,
                                                     "Load Project",
                                                     "QDir::rootPath()",
-                                                    "SSP Files (.ssp);;All Files (*)");
-    if (!filePath.isEmpty())
+                                                    "SSP Files (*.ssp);;All Files (*)");
+    if (filePath.isEmpty())
     {
-        QFile file(filePath);
-        // Attempt to open the file for reading
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-        {
-            QMessageBox::warning(nullptr, "Error", "Unable to open the file.");
-            return;
-        }
+        return;
+    }
 
-        // Read the entire file content into a QByteArray
-        QByteArray fileData = file.readAll();
-        file.close();
+    pendingLoadPath = filePath;
+    projectIO->load(filePath, frameMemoryBudget, pager);
+}
 
-        frames.clear();
-        frames.push_back(*image);
-        currentFrameIndex = 0;
+void Model::projectLoaded(bool ok, const QString &error)
+{
+    emit projectTaskFinished();
+    if (ok)
+    {
+        projectPath = pendingLoadPath;
+        replaceFrames(projectIO->takeLoadedFrames());
+        startJournal(projectPath, frameIds());
+    }
+    else if (!error.isEmpty())
+    {
+        QMessageBox::warning(nullptr, "Error", "Unable to load the project.\n" + error);
+    }
+}
 
-        QJsonDocument doc = QJsonDocument::fromJson(fileData);
-        if (doc.isObject())
-        {
-            // Extract width and frameCount from the JSON object
-            QJsonObject jsonObject = doc.object();
-            int width = jsonObject["width"].toInt();
-            size = width;
-            emit requestWindowResize(size);
-            int frameCount = jsonObject["frameCount"].toInt();
+void Model::cancelProjectTask()
+{
+    projectIO->cancel();
+}
 
-            QJsonArray jsonFrames = jsonObject["frames"].toArray();
+void Model::touchFrame(size_t index, const QRect &rect)
+{
+    FrameState &state = frameStates[index];
+    state.generation = ++editGeneration;
+    state.dirty |= rect;
+    if (index == currentFrameIndex)
+        canvasChanged |= rect;
+}
 
-            // Create additional frames if needed
-            for (int i = 0; i < frameCount - 1; i++)
-            {
-                emit requestNewFrame();
-            }
+void Model::touchLayout()
+{
+    layoutGeneration = ++editGeneration;
+}
 
-            int frameIndex = 0;
-            // Load each frame's pixel data from the JSON array
-            for (const QJsonValue &frameValue : jsonFrames)
-            {
-                selectFrame(frameIndex);
-                QJsonArray frameArray = frameValue.toArray();
-
-                // Loop through every set of 4 values (RGBA) for the frame
-                for (int i = 0; i < frameArray.size() / 4; i++)
-                {
-                    int red = frameArray[4 * i].toInt();
-                    int green = frameArray[4 * i + 1].toInt();
-                    int blue = frameArray[4 * i + 2].toInt();
-                    int alpha = frameArray[4 * i + 3].toInt();
-
-                    QColor color(red, green, blue, alpha);
-                    // Determine pixel coordinates using modulus and division
-                    setPixel(i % (int)size, i / size, color);
-                }
-                frameIndex++;
-            }
-            selectFrame(0);
-            emit framesReloaded();
-        }
-        else
+Model::FrameState Model::newFrameState(const QRect &dirty)
+{
+    touchLayout();
+    return FrameState{nextFrameId++, editGeneration, dirty};
+}
+
+void Model::resetFrameStates()
+{
+    frameStates.clear();
+    for (size_t i = 0; i < frames.size(); i++)
+        frameStates.push_back(FrameState{nextFrameId++, editGeneration, QRect()});
+    layoutGeneration = editGeneration;
+    autosavedGeneration = editGeneration;
+    baseGeneration = editGeneration;
+}
+
+std::vector<quint32> Model::frameIds() const
+{
+    std::vector<quint32> ids;
+    ids.reserve(frameStates.size());
+    for (const FrameState &state : frameStates)
+        ids.push_back(state.id);
+    return ids;
+}
+
+void Model::startJournal(const QString &baseProject, const std::vector<quint32> &baseIds)
+{
+    QString journalPath;
+    if (projectPath.isEmpty())
+    {
+        QString folder = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        QDir().mkpath(folder);
+        journalPath = folder + "/untitled.autosave";
+    }
+    else
+    {
+        journalPath = projectPath + ".autosave";
+    }
+
+    // The new journal is written right away, a journal left at the same path from before names the old base's frame
+    // ids and would replay its edits onto the wrong frames
+    journalBase = baseProject;
+    journalBaseIds = baseIds;
+    journalBroken = false;
+    lastSaveFailed = false;
+    journal.reset(journalPath, int(size), journalBase, journalBaseIds);
+    commitJournal();
+}
+
+void Model::autosave()
+{
+    if (editGeneration == autosavedGeneration)
+    {
+        return;
+    }
+
+    // Repeated edits to the same areas pile up, rewrite the journal once it is larger than the frames themselves
+    qint64 frameBytes = qint64(frames.size()) * qint64(size) * qint64(size) * qint64(sizeof(QRgb));
+    if (journalBroken || journal.size() > std::max(COMPACT_MIN_BYTES, 2 * frameBytes))
+    {
+        rebuildJournal();
+        return;
+    }
+
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        FrameState &state = frameStates[i];
+        if (state.generation > autosavedGeneration && !state.dirty.isEmpty())
         {
-            QMessageBox::warning(nullptr, "Error", "The JSON format is incorrect.");
+            journal.addFrame(state.id, frameImage(i), state.dirty & canvasRect());
+            state.dirty = QRect();
         }
     }
+    if (layoutGeneration > autosavedGeneration)
+    {
+        journal.addLayout(frameIds());
+    }
+    autosavedGeneration = editGeneration;
+    commitJournal();
+}
+
+void Model::rebuildJournal()
+{
+    journal.reset(journal.path(), int(size), journalBase, journalBaseIds);
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        FrameState &state = frameStates[i];
+        if (state.generation > baseGeneration)
+            journal.addFrame(state.id, frameImage(i), canvasRect());
+        state.dirty = QRect();
+    }
+    journal.addLayout(frameIds());
+    autosavedGeneration = editGeneration;
+    commitJournal();
+}
+
+void Model::commitJournal()
+{
+    QString error;
+    journalBroken = !journal.commit(error);
+    if (journalBroken)
+    {
+        qWarning("Autosave failed: %s", qUtf8Printable(error));
+        return;
+    }
+
+    QSettings settings;
+    if (settings.value(JOURNAL_KEY).toString() != journal.path())
+        settings.setValue(JOURNAL_KEY, journal.path());
+}
+
+void Model::recoverAutosave()
+{
+    QSettings settings;
+    QString journalPath = settings.value(JOURNAL_KEY).toString();
+    if (journalPath.isEmpty() || !AutosaveJournal::hasEdits(journalPath))
+    {
+        return;
+    }
+
+    if (QMessageBox::question(nullptr,
+                              "Recover Work",
+                              "The editor did not close properly last time. Recover the unsaved changes?") != QMessageBox::Yes)
+    {
+        QFile::remove(journalPath);
+        settings.remove(JOURNAL_KEY);
+        return;
+    }
+
+    AutosaveJournal::Recovery recovery;
+    QString error;
+    if (!AutosaveJournal::replay(journalPath, recovery, error))
+    {
+        QMessageBox::warning(nullptr, "Error", "Unable to recover the unsaved changes.\n" + error);
+        return;
+    }
+
+    // The recovered frames are written out in full to a fresh journal in the same place, which also drops any
+    // record the crash cut short
+    projectPath = recovery.baseProject;
+    std::vector<TiledFrame> recovered;
+    recovered.reserve(recovery.frames.size());
+    for (const QImage &image : recovery.frames)
+        recovered.emplace_back(image);
+    TiledFrame::shareTiles(recovered);
+    replaceFrames(std::move(recovered));
+    startJournal(QString(), {});
+    for (size_t i = 0; i < frames.size(); i++)
+        touchFrame(i, canvasRect());
+    touchLayout();
+    rebuildJournal();
 }
@@ -3,10 +3,18 @@
 #define MODELS_H
 
 #include <QObject>
+#include <QElapsedTimer>
 #include <QImage>
 #include <vector>
 #include <QMouseEvent>
 #include <QGraphicsSceneMouseEvent>
+#include "autosavejournal.h"
+#include "brush.h"
+#include "floodfill.h"
+#include "projectio.h"
+#include "stroketracker.h"
+#include "tiledframe.h"
+#include "transforms.h"
 
 /**
  * University of Utah – CS 3505
@@ -31,11 +39,23 @@ public:
     ~Model();
 
     /**
-     * @brief getImage - returns a reference to the QImage
+     * @brief getImage - returns the frame currently being edited
+     * The current frame is kept unpacked while it is edited, the image is refreshed whenever another frame is selected
      * @return QImage object
      */
     QImage *getImage();
 
+    /**
+     * @brief beginEdit - starts an edit transaction
+     * Changes made until the matching endEdit are gathered into one canvasUpdated signal. Transactions may be nested
+     */
+    void beginEdit();
+
+    /**
+     * @brief endEdit - ends an edit transaction and schedules one canvasUpdated signal for everything that changed
+     */
+    void endEdit();
+
     /**
      * @brief createImage - creates a new QImage object with the parameter size
      * @param size - the dimensions of the created QImage
@@ -43,28 +63,32 @@ public:
     void createImage(int size);
 
     /**
-     * Sets the color at a specific pixel coordinate in the image to the selected color
-     * @brief setPixel
-     * @param x coordinate of pixel
-     * @param y coordinate of pixel
-     * @param userColor - new rgb value of the pixel
+     * @brief replaceFrames - replaces every frame at once and selects the first one
+     * The frames are taken as they are, the canvas size follows them and framesReloaded is emitted once
+     * @param newFrames - the new frames, at least one, all of the same size
      */
-    void setPixel(int x, int y, QColor userColor);
+    void replaceFrames(std::vector<TiledFrame> newFrames);
 
     /**
-     * @brief setPixelTracker - identifies if the current pixel is colored with the users current color and either ignores or colors the pixel
-     * @param x - x cooridnate of the pixel
-     * @param y - y cooridnate of the pixel
+     * @brief strokeLine - stamps the brush at every pixel on the line between two points with the user color
+     * Stamps are written as whole spans, pixels already painted by this stroke are skipped and points outside the
+     * canvas are clipped. Pass the same point twice to stamp once
+     * @param x0 - x coordinate of the previous brush position
+     * @param y0 - y coordinate of the previous brush position
+     * @param x1 - x coordinate of the new brush position
+     * @param y1 - y coordinate of the new brush position
      * @param userColor - current color selected by user
      */
-    void setPixelTracker(int x, int y, QColor userColor);
+    void strokeLine(int x0, int y0, int x1, int y1, QColor userColor);
 
     /**
-     * @brief erasePixel - erases the pixel at the coordinates in the image to be empty
-     * @param x - x cooridnate of the pixel
-     * @param y - y cooridnate of the pixel
+     * @brief eraseLine - erases the undithered brush stamp along the line between two points, clipped to the canvas
+     * @param x0 - x coordinate of the previous eraser position
+     * @param y0 - y coordinate of the previous eraser position
+     * @param x1 - x coordinate of the new eraser position
+     * @param y1 - y coordinate of the new eraser position
      */
-    void erasePixel(int x, int y);
+    void eraseLine(int x0, int y0, int x1, int y1);
 
     /**
      * @brief getPixel - Returns the color/RGBA value at the selected pixel coordinate
@@ -101,6 +125,45 @@ public:
      */
     void removeFrame(unsigned int index);
 
+    /**
+     * @brief insertBlankFrames - inserts blank frames and selects the first of them
+     * @param index - where the first new frame goes, the frame count to append them
+     * @param count - number of frames to insert
+     */
+    void insertBlankFrames(size_t index, size_t count);
+
+    /**
+     * @brief duplicateFrames - inserts copies of a run of frames right after it and selects the first copy
+     * The copies share all of their tiles with the originals until either is edited
+     * @param first - index of the first frame to copy
+     * @param count - number of frames to copy
+     */
+    void duplicateFrames(size_t first, size_t count);
+
+    /**
+     * @brief removeFrames - removes a run of frames, removing every frame keeps the first one and clears it
+     * A removed selected frame gives way to the frame before the run
+     * @param first - index of the first frame to remove
+     * @param count - number of frames to remove
+     */
+    void removeFrames(size_t first, size_t count);
+
+    /**
+     * @brief reverseFrames - reverses the order of a run of frames without copying any pixels
+     * @param first - index of the first frame of the run
+     * @param count - number of frames in the run
+     */
+    void reverseFrames(size_t first, size_t count);
+
+    /**
+     * @brief addPingPongFrames - makes a run of frames play forwards and then backwards by inserting copies of its
+     * inner frames in reverse order right after it, so A B C D becomes A B C D C B
+     * The copies share all of their tiles with the originals. Runs shorter than three frames are left as they are
+     * @param first - index of the first frame of the run
+     * @param count - number of frames in the run
+     */
+    void addPingPongFrames(size_t first, size_t count);
+
     /**
      * @brief Selects the specified frame and updates the main canvas
      * @param index the frame to select
@@ -114,19 +177,73 @@ public:
     unsigned int getCurrentFrameIndex() const;
 
     /**
-     * @brief Helper to return a thumbnail for a given frame
-     * @param index the frame to generate the thumbnail for
-     * @param width width of the thumbnail
-     * @param height height of the thumbnail
-     * @return A QPixmap for use as a thumbnail for a frame
+     * @brief Returns the number of frames in the animation
+     * Frames themselves are only reached by index, through getImage and getFrameSnapshot, since they may be packed
+     * or paged out to disk
+     * @return the number of frames
+     */
+    size_t getFrameCount() const;
+
+    /**
+     * @brief getFrameId - returns the id of a frame, which stays with the frame when frames move
+     * @param index - the frame
+     */
+    quint32 getFrameId(size_t index) const;
+
+    /**
+     * @brief getFrameGeneration - returns the edit generation of a frame, which grows every time the frame changes
+     * @param index - the frame
+     */
+    quint64 getFrameGeneration(size_t index) const;
+
+    /**
+     * @brief findFrame - finds a frame by its id
+     * @param id - the frame's id
+     * @return the frame's index, -1 if no frame has the id
+     */
+    int findFrame(quint32 id) const;
+
+    /**
+     * @brief getFrameSnapshot - copies a frame so it can be read on another thread
+     * The copy shares its tiles with the frame, so it is cheap to make and later edits do not affect it
+     * @param index - the frame
+     */
+    TiledFrame getFrameSnapshot(size_t index);
+
+    /**
+     * @brief getStoredFrame - copies a frame other than the current one like getFrameSnapshot, but without storing the
+     * canvas, so it can be called while painting
+     * @param index - the frame, not the current one
+     */
+    TiledFrame getStoredFrame(size_t index) const;
+
+    /**
+     * @brief getFrameMemoryUsage - measures the memory the frames use and how much of it duplicated frames share
+     * @return the usage of the tiled frames plus the unpacked current frame
+     */
+    TiledFrame::Usage getFrameMemoryUsage() const;
+
+    /**
+     * @brief findDuplicateFrames - finds frames with exactly the same pixels and makes each group share one copy
+     * Frames are compared by their content hashes, which are kept up to date as tiles change, and confirmed pixel by
+     * pixel. Tiles repeated anywhere in the animation are merged at the same time
+     * @return every group of two or more identical frames as ascending frame indices
+     */
+    std::vector<std::vector<size_t>> findDuplicateFrames();
+
+    /**
+     * @brief getFrameMemoryBudget - the most memory the frames should use, 0 when there is no limit
      */
-    QPixmap getFrameThumbnail(int index, int width, int height) const;
+    qint64 getFrameMemoryBudget() const;
 
     /**
-     * @brief Returns a reference to the list of all frames in the animation
-     * @return a list containing all of the frames
+     * @brief setFrameMemoryBudget - limits the memory the frames use by packing frames nobody looked at recently
+     * The current frame and the few frames used most recently always stay unpacked. When packing is not enough,
+     * packed frames are paged out to a scratch file. Packed and paged frames are unpacked again when they are
+     * selected, the animation preview reads them without unpacking. The budget is remembered between sessions
+     * @param bytes - the limit in bytes, 0 for no limit
      */
-    const std::vector<QImage> &getFrames() const;
+    void setFrameMemoryBudget(qint64 bytes);
 
     /**
      * @brief shiftFrameUp - shifts the current frame above
@@ -144,6 +261,24 @@ public:
      */
     void swapFrame(bool swapUp);
 
+    /**
+     * @brief moveFrames - moves a run of frames to another place in the animation
+     * Only the frames' tile lists change places, no pixels are copied, and framesMoved is emitted once. The selected
+     * frame stays selected wherever it ends up. Moves that would leave the frames where they are do nothing
+     * @param first - index of the first frame to move
+     * @param count - number of frames to move
+     * @param destination - index, counted before the move, of the frame the run is put in front of, the frame count
+     * to move the run to the end
+     */
+    void moveFrames(size_t first, size_t count, size_t destination);
+
+    /**
+     * @brief moveFrame - moves one frame so it ends up at the given index
+     * @param from - index of the frame to move
+     * @param to - index the frame has after the move
+     */
+    void moveFrame(size_t from, size_t to);
+
     /**
      * @brief addToPalette - adds the QColor to the palette vector
      * @param QColor - current color by user to be added to palette
@@ -186,6 +321,14 @@ public:
      */
     void ellipseShape(int x, int y, QColor usercolor);
 
+    /**
+     * @brief lineShape - previews a straight line from the shape start point, the line tool's shape
+     * @param x - x cooridnate of the pixel
+     * @param y - y cooridnate of the pixel
+     * @param usercolor - users current brush color
+     */
+    void lineShape(int x, int y, QColor usercolor);
+
     /**
      * @brief getShapePreview - returns the QImage that contains a preview of the shape
      * @return QImage object
@@ -193,23 +336,38 @@ public:
     QImage *getShapePreview();
 
     /**
-     * @brief mergeShapePreview - draws the shape preview onto the base canvas
+     * @brief mergeShapePreview - blends the shape preview onto the base canvas, only inside the shape's box
      */
     void mergeShapePreview();
 
     /**
-     * @brief paintBucket The paint bucket tool
+     * @brief transformFrames - flips, rotates or transposes the current frame or every frame
+     * @param operation - the transform to apply
+     * @param allFrames - true to transform every frame of the animation, false for only the current frame
+     */
+    void transformFrames(FrameTransform::Operation operation, bool allFrames);
+
+    /**
+     * @brief paintBucket The paint bucket tool, fills using the current fill options
      * @param x X cordinate
      * @param y Y cordiante
      * @param userColor The users color
      */
     void paintBucket(int x, int y, QColor userColor);
 
+    /**
+     * @brief recoverAutosave - offers to restore the edits an autosave journal kept when the editor last closed
+     * without shutting down cleanly, meant to be called once at startup
+     */
+    void recoverAutosave();
+
 signals:
     /**
      * @brief canvasUpdated - signal sent to the View to update the canvas preview
+     * Changes are coalesced, so this is emitted at most once per event loop turn and never inside an edit transaction
+     * @param dirty - the area of the canvas and shape preview that changed
      */
-    void canvasUpdated();
+    void canvasUpdated(const QRect &dirty);
 
     /**
      * Emitted when a frame's content is modified.
@@ -252,14 +410,56 @@ signals:
      */
     void requestNewSelectedFrameIndex(unsigned int index);
 
-    /// Emitted after all frames are reloaded from file.
+    /**
+     * Emitted once after frames were inserted, before any of them is selected.
+     * @param first Index of the first new frame.
+     * @param count Number of new frames.
+     */
+    void framesInserted(int first, int count);
+
+    /**
+     * Emitted once after a run of frames was removed.
+     * @param first Index the first removed frame had.
+     * @param count Number of removed frames.
+     */
+    void framesRemoved(int first, int count);
+
+    /**
+     * Emitted once after the order of a run of frames was reversed, the frames themselves did not change.
+     * @param first Index of the first frame of the run.
+     * @param count Number of frames in the run.
+     */
+    void framesReversed(int first, int count);
+
+    /**
+     * Emitted once after a run of frames moved, the frames themselves did not change.
+     * @param first Index of the first moved frame before the move.
+     * @param count Number of moved frames.
+     * @param destination Index, counted before the move, of the frame the run was put in front of.
+     */
+    void framesMoved(int first, int count, int destination);
+
+    /// Emitted once after the whole frame list was replaced, the canvas size may have changed.
     void framesReloaded();
 
+    /// Emitted when the pixels of every frame changed but the frame list itself did not.
+    void allFramesModified();
+
     /**
-     * Emitted when canvas size changes.
-     * @param size The new canvas dimension.
+     * Emitted when a background save or load starts.
+     * @param description Text describing the operation for the user.
      */
-    void requestWindowResize(unsigned int size);
+    void projectTaskStarted(const QString &description);
+
+    /**
+     * Emitted as a background save or load makes progress.
+     * @param percent How much of the operation is done, from 0 to 100.
+     */
+    void projectTaskProgress(int percent);
+
+    /// Emitted when a background save or load ended, whether it succeeded, failed or was cancelled.
+    void projectTaskFinished();
+
 
 public slots:
     /**
@@ -284,15 +484,23 @@ public slots:
     void toggleAnimation();
 
     /**
-     * @brief saveProject - saves the project to an spp file to a user-chosen destination
+     * @brief saveProject - saves the project to an ssp file to a user-chosen destination
+     * The binary format is used unless the user picks the legacy JSON format in the dialog. The file is written in
+     * the background from a snapshot of the frames, so editing can continue while it saves
      */
     void saveProject();
 
     /**
-     * @brief loadProject - loads an spp file into the project
+     * @brief loadProject - loads a binary or legacy JSON ssp file into the project
+     * The file is read in the background and the project is only replaced once every frame was decoded
      */
     void loadProject();
 
+    /**
+     * @brief cancelProjectTask - stops a running background save or load, leaving the project and files as they were
+     */
+    void cancelProjectTask();
+
     /**
      * @brief mirrorFrame - mirrors the canvas vertically
      */
@@ -303,6 +511,54 @@ public slots:
      */
     void rotateFrame();
 
+    /**
+     * @brief setFillTolerance - sets how far a color may be from the start color and still be filled
+     * @param tolerance - the largest per-channel difference, 0 for exact matches
+     */
+    void setFillTolerance(int tolerance);
+
+    /**
+     * @brief setFillDiagonal - sets whether the paint bucket spreads to diagonal neighbours
+     * @param enabled - true for 8-connected fills, false for 4-connected fills
+     */
+    void setFillDiagonal(bool enabled);
+
+    /**
+     * @brief setFillGlobal - sets whether the paint bucket fills every matching pixel instead of only the connected region
+     * @param enabled - true to fill all matching pixels
+     */
+    void setFillGlobal(bool enabled);
+
+    /**
+     * @brief setBrushSize - sets the width and height of the brush and eraser stamp
+     * @param size - the stamp size in pixels, from Brush::MIN_SIZE to Brush::MAX_SIZE
+     */
+    void setBrushSize(int size);
+
+    /**
+     * @brief setBrushShape - sets the outline of the brush and eraser stamp
+     * @param shape - the stamp shape
+     */
+    void setBrushShape(Brush::Shape shape);
+
+    /**
+     * @brief setBrushDither - sets the dither pattern the brush paints with
+     * @param dither - the dither pattern
+     */
+    void setBrushDither(Brush::Dither dither);
+
+    /**
+     * @brief setCustomBrushStamp - sets the image used by the custom brush shape
+     * @param stamp - image whose non-transparent pixels form the stamp
+     */
+    void setCustomBrushStamp(const QImage &stamp);
+
+    /**
+     * @brief setShapeFilled - sets whether rectangles and ellipses are drawn filled or as outlines
+     * @param filled - true to fill shapes
+     */
+    void setShapeFilled(bool filled);
+
 private:
     /**
      * Determines the dimensions of our square canvas
@@ -311,17 +567,37 @@ private:
     double size;
 
     /**
-     * The main canvas displayed on the users screen
-     * The size is determined by the user input and is then scaled by 10x factor
-     * @brief image
+     * Stores all animation frames as tiles shared between frames wherever their pixels are the same.
+     * Each frame represents one image in the animation sequence.
+     * The current frame is edited in canvas and its changed tiles are written back by storeCanvas
      */
-    QImage *image;
+    std::vector<TiledFrame> frames;
 
     /**
-     * Stores all animation frames as QImage objects.
-     * Each frame represents one image in the animation sequence.
+     * @brief canvas - the current frame unpacked into one image, the image every tool draws on
+     */
+    QImage canvas;
+
+    /**
+     * @brief canvasChanged - the area of the canvas edited since it was last stored into its frame
+     */
+    QRect canvasChanged;
+
+    /**
+     * @brief storeCanvas - writes the tiles of the canvas that were edited back into the current frame
+     */
+    void storeCanvas();
+
+    /**
+     * @brief loadCanvas - unpacks the current frame into the canvas
      */
-    std::vector<QImage> frames;
+    void loadCanvas();
+
+    /**
+     * @brief frameImage - returns a frame as one image, the canvas itself for the current frame
+     * @param index - the frame
+     */
+    QImage frameImage(size_t index) const;
 
     /**
      * The index of the currently selected frame being edited.
@@ -341,6 +617,16 @@ private:
      */
     int animationIndex = 0;
 
+    /**
+     * Time since playback started or the speed last changed, frames are due at whole multiples of the frame time.
+     */
+    QElapsedTimer animationClock;
+
+    /**
+     * Number of frame times that had passed on the clock when animationIndex was shown, -1 before the first frame.
+     */
+    qint64 animationTick = -1;
+
     /**
      * Animation playback state flag.
      * @value true Animation is currently playing
@@ -350,10 +636,15 @@ private:
 
     /**
      * Timer object that controls animation playback timing.
-     * Fires at intervals based on animationFps to advance frames.
+     * Fires once for every frame, when the clock says the next one is due.
      */
     QTimer *animationTimer = nullptr;
 
+    /**
+     * @brief restartAnimationClock - plays on from the frame shown, at the current speed
+     */
+    void restartAnimationClock();
+
     /**
      * @brief mousePressEvent - handles when the mouse buttons have been pressed by user
      * @param event
@@ -378,22 +669,267 @@ private:
     QColor selectColor;
 
     /**
-     * @brief blendAdditive - blends two colors at the same pixel if one color has an alpha value < 225
-     * @param dest - color at the selected pixel
-     * @param src - current user brush color
-     * @return new QColor value that is a blend of both dest and src values
+     * @brief tracker - the pixels the current brush stroke has already painted
+     */
+    StrokeTracker tracker;
+
+    /**
+     * @brief shapePreview - temporray preview of the shape object overlayed above the cuurent canvas image while the user is still creating the shape
      */
-    QColor blendAdditive(QColor dest, QColor src);
+    QImage *shapePreview = nullptr;
 
     /**
-     * @brief tracker - tracks the users current changes to pixel coordinates
+     * @brief shapePreviewRect - the area of the shape preview that currently holds a shape
      */
-    QImage *tracker;
+    QRect shapePreviewRect;
 
     /**
-     * @brief shapePreview - temporray preview of the shape object overlayed above the cuurent canvas image while the user is still creating the shape
+     * @brief pendingDirty - the area changed since the last canvasUpdated signal
      */
-    QImage *shapePreview;
+    QRect pendingDirty;
+
+    /**
+     * @brief editDepth - how many edit transactions are currently open
+     */
+    int editDepth = 0;
+
+    /**
+     * @brief canvasUpdateTimer - zero-length timer that sends the pending update once control returns to the event loop
+     */
+    QTimer *canvasUpdateTimer = nullptr;
+
+    /**
+     * @brief markDirty - records a changed area and schedules a coalesced canvasUpdated signal
+     * @param rect - the area of the canvas or shape preview that changed
+     */
+    void markDirty(const QRect &rect);
+
+    /**
+     * @brief canvasRect - the rect covering the whole canvas
+     * @return a rect from (0, 0) to the canvas size
+     */
+    QRect canvasRect() const;
+
+    /**
+     * @brief resetScratchImages - sizes the stroke tracker and shape preview to the canvas and clears them
+     */
+    void resetScratchImages();
+
+    /**
+     * @brief Autosave and memory bookkeeping for one frame, kept in the same order as the frames
+     */
+    struct FrameState
+    {
+        // Stays with the frame when frames move, so the journal can tell frames apart
+        quint32 id;
+        // Value of editGeneration when the frame last changed
+        quint64 generation;
+        // Area changed since the last autosave
+        QRect dirty;
+        // Value of useCounter when the frame was last selected
+        quint64 lastUsed = 0;
+    };
+
+    /**
+     * @brief frameStates - autosave bookkeeping for every frame
+     */
+    std::vector<FrameState> frameStates;
+
+    /**
+     * @brief nextFrameId - id given to the next new frame
+     */
+    quint32 nextFrameId = 0;
+
+    /**
+     * @brief editGeneration - counts edits, every change to a frame or the frame order takes the next value
+     */
+    quint64 editGeneration = 0;
+
+    /**
+     * @brief layoutGeneration - value of editGeneration when frames were last added, removed or moved
+     */
+    quint64 layoutGeneration = 0;
+
+    /**
+     * @brief autosavedGeneration - value of editGeneration the journal is up to date with
+     */
+    quint64 autosavedGeneration = 0;
+
+    /**
+     * @brief baseGeneration - value of editGeneration the journal's base project matches
+     */
+    quint64 baseGeneration = 0;
+
+    /**
+     * @brief journal - the autosave journal of the edits since the project was created, loaded or saved
+     */
+    AutosaveJournal journal;
+
+    /**
+     * @brief journalBase and journalBaseIds - the base project of the journal and the ids of its frames
+     */
+    QString journalBase;
+    std::vector<quint32> journalBaseIds;
+
+    /**
+     * @brief journalBroken - set when an autosave failed, so the next one rewrites the whole journal
+     */
+    bool journalBroken = false;
+
+    /**
+     * @brief autosaveTimer - runs autosave periodically
+     */
+    QTimer *autosaveTimer = nullptr;
+
+    /**
+     * @brief projectPath - the file the project was last loaded from or saved to, empty for a new canvas
+     */
+    QString projectPath;
+
+    /**
+     * @brief pendingSavePath, pendingSaveGeneration and pendingSaveIds - the destination, edit generation and frame
+     * ids of the snapshot a running save is writing
+     */
+    QString pendingSavePath;
+    quint64 pendingSaveGeneration = 0;
+    std::vector<quint32> pendingSaveIds;
+
+    /**
+     * @brief lastSaveFailed - set when the last save of the current frames failed or was cancelled, so closing keeps
+     * the journal
+     */
+    bool lastSaveFailed = false;
+
+    /**
+     * @brief pendingLoadPath - the file a running load is reading
+     */
+    QString pendingLoadPath;
+
+    /**
+     * @brief insertFrames - inserts frames and their bookkeeping and emits framesInserted, the selection keeps its frame
+     * @param index - where the first new frame goes
+     * @param newFrames - the frames to insert
+     * @param dirty - the area of every new frame the journal has to record, empty for blank frames
+     */
+    void insertFrames(size_t index, std::vector<TiledFrame> newFrames, const QRect &dirty);
+
+    /**
+     * @brief touchFrame - records that an area of a frame changed
+     * @param index - the frame
+     * @param rect - the changed area
+     */
+    void touchFrame(size_t index, const QRect &rect);
+
+    /**
+     * @brief touchLayout - records that frames were added, removed or moved
+     */
+    void touchLayout();
+
+    /**
+     * @brief newFrameState - bookkeeping for a frame that was just added
+     * @param dirty - the area of the new frame that is not blank
+     */
+    FrameState newFrameState(const QRect &dirty);
+
+    /**
+     * @brief resetFrameStates - gives every frame a new id and marks them all unchanged
+     */
+    void resetFrameStates();
+
+    /**
+     * @brief frameIds - the frame ids in animation order
+     */
+    std::vector<quint32> frameIds() const;
+
+    /**
+     * @brief startJournal - starts a new autosave journal next to the project, or in the application data folder
+     * for a project that was never saved, and writes it over any journal already there
+     * @param baseProject - the project file the frames are unchanged from up to baseGeneration
+     * @param baseIds - the ids of that file's frames in file order
+     */
+    void startJournal(const QString &baseProject, const std::vector<quint32> &baseIds);
+
+    /**
+     * @brief rebuildJournal - rewrites the journal with the whole content of every frame changed since its base,
+     * dropping the older records
+     */
+    void rebuildJournal();
+
+    /**
+     * @brief commitJournal - writes the gathered journal records and remembers the journal for crash recovery
+     */
+    void commitJournal();
+
+    /**
+     * @brief frameMemoryBudget - the most bytes the frames should use, 0 for no limit
+     */
+    qint64 frameMemoryBudget = 0;
+
+    /**
+     * @brief useCounter - counts frame uses, every use of a frame takes the next value
+     */
+    quint64 useCounter = 0;
+
+    /**
+     * @brief useFrame - marks a frame as just used and unpacks it if it was packed
+     * @param index - the frame
+     */
+    void useFrame(size_t index);
+
+    /**
+     * @brief pager - the scratch file frames are paged out to, created once the first frame is paged out
+     */
+    FramePager pager;
+
+    /**
+     * @brief enforceFrameBudget - packs the frames used longest ago until the frames fit the memory budget, then
+     * pages packed frames out if that was not enough
+     */
+    void enforceFrameBudget();
+
+    /**
+     * @brief prefetchFrames - has the paged frames of a range of indices read in from the scratch file in the background
+     * @param first - first frame of the range, may be outside the frames
+     * @param last - last frame of the range, inclusive
+     * @param wrap - true to wrap indices past the last frame around to the first, as the animation does
+     */
+    void prefetchFrames(int first, int last, bool wrap);
+
+    /**
+     * @brief projectIO - saves and loads project files on a worker thread
+     */
+    ProjectIO *projectIO = nullptr;
+
+    /**
+     * @brief projectIOBusy - tells the user a save or load is still running
+     * @return true if another save or load cannot start yet
+     */
+    bool projectIOBusy();
+
+    /**
+     * @brief clearShapePreview - clears the part of the shape preview the last shape covered
+     */
+    void clearShapePreview();
+
+    /**
+     * @brief previewSpan - writes a run of one row of the shape preview, clipped to the canvas
+     * @param y - the row
+     * @param left - first column of the run
+     * @param right - last column of the run, inclusive
+     * @param color - the shape color
+     */
+    void previewSpan(int y, int left, int right, QRgb color);
+
+    /**
+     * @brief showShapePreview - marks the old and new shape boxes dirty and remembers the new one
+     * @param shapeRect - the box of the shape just drawn into the preview
+     */
+    void showShapePreview(const QRect &shapeRect);
+
+    /**
+     * @brief shapeFilled - whether rectangles and ellipses are filled
+     */
+    bool shapeFilled = false;
 
     /**
      * @brief shapeStartX - starting x-coordinate of the shape
@@ -411,16 +947,38 @@ private:
     QVector<QColor> palette;
 
     /**
-     * @brief paintBucketRecursive Recursive method for paint bucket
-     * @param x X cordinate
-     * @param y Y cordinate
-     * @param userColor The users color
-     * @param colorToReplace The color to replace
+     * @brief fillOptions - tolerance, connectivity and global mode used by the paint bucket
+     */
+    FloodFill::Options fillOptions;
+
+    /**
+     * @brief brush - stamp masks used by the brush and eraser tools
      */
-    void paintBucketRecursive(int x, int y, QColor userColor, QColor colorToReplace);
+    Brush brush;
 
 private slots:
     void updateAnimationFrame();
+
+    /**
+     * @brief flushCanvasUpdate - emits canvasUpdated for everything changed since the last one, unless a transaction is open
+     */
+    void flushCanvasUpdate();
+
+    /**
+     * @brief autosave - appends the areas and frame order changed since the last autosave to the journal, the work
+     * done is proportional to what changed
+     */
+    void autosave();
+
+    /**
+     * @brief projectSaved - reports a failed background save
+     */
+    void projectSaved(bool ok, const QString &error);
+
+    /**
+     * @brief projectLoaded - replaces the frames with the ones a background load decoded, or reports why it failed
+     */
+    void projectLoaded(bool ok, const QString &error);
 };
 
 #endif // MODELS_H
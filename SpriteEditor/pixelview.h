@@ -0,0 +1,111 @@
+#ifndef PIXELVIEW_H
+#define PIXELVIEW_H
+
+#include <QImage>
+#include <QRgb>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Typed access to the raw scanlines of an ARGB32 image.
+ * Pixels are read and written as QRgb values without the bounds checks, format conversions and QColor construction
+ * of QImage::pixelColor and QImage::setPixelColor. Callers are responsible for staying inside the image
+ */
+class PixelView
+{
+public:
+    /**
+     * @brief PixelView - creates a writable view, detaching the image once if its data is shared
+     * The view is only valid while the image is alive and not reassigned
+     * @param image - an ARGB32 image
+     */
+    explicit PixelView(QImage &image)
+        : data(image.bits()), stride(image.bytesPerLine()), viewWidth(image.width()), viewHeight(image.height())
+    {
+        Q_ASSERT(image.format() == QImage::Format_ARGB32);
+    }
+
+    /**
+     * @brief width - the width of the image in pixels
+     */
+    int width() const { return viewWidth; }
+
+    /**
+     * @brief height - the height of the image in pixels
+     */
+    int height() const { return viewHeight; }
+
+    /**
+     * @brief contains - checks if a coordinate is inside the image
+     */
+    bool contains(int x, int y) const { return x >= 0 && x < viewWidth && y >= 0 && y < viewHeight; }
+
+    /**
+     * @brief row - returns the pixels of one scanline
+     * @param y - the row to return
+     */
+    QRgb *row(int y) const { return reinterpret_cast<QRgb *>(data + y * stride); }
+
+    /**
+     * @brief at - returns a reference to one pixel
+     */
+    QRgb &at(int x, int y) const { return row(y)[x]; }
+
+private:
+    uchar *data;
+    qsizetype stride;
+    int viewWidth;
+    int viewHeight;
+};
+
+/**
+ * @brief Read only typed access to the raw scanlines of an ARGB32 image. Never detaches the image
+ */
+class ConstPixelView
+{
+public:
+    /**
+     * @brief ConstPixelView - creates a read only view
+     * @param image - an ARGB32 image
+     */
+    explicit ConstPixelView(const QImage &image)
+        : data(image.constBits()), stride(image.bytesPerLine()), viewWidth(image.width()), viewHeight(image.height())
+    {
+        Q_ASSERT(image.format() == QImage::Format_ARGB32);
+    }
+
+    /**
+     * @brief width - the width of the image in pixels
+     */
+    int width() const { return viewWidth; }
+
+    /**
+     * @brief height - the height of the image in pixels
+     */
+    int height() const { return viewHeight; }
+
+    /**
+     * @brief contains - checks if a coordinate is inside the image
+     */
+    bool contains(int x, int y) const { return x >= 0 && x < viewWidth && y >= 0 && y < viewHeight; }
+
+    /**
+     * @brief row - returns the pixels of one scanline
+     * @param y - the row to return
+     */
+    const QRgb *row(int y) const { return reinterpret_cast<const QRgb *>(data + y * stride); }
+
+    /**
+     * @brief at - returns one pixel
+     */
+    QRgb at(int x, int y) const { return row(y)[x]; }
+
+private:
+    const uchar *data;
+    qsizetype stride;
+    int viewWidth;
+    int viewHeight;
+};
+
+#endif // PIXELVIEW_H
@@ -0,0 +1,362 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the binary project format.
+ */
+
+#include "projectfile.h"
+#include "contenthash.h"
+#include "pixelview.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QtEndian>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+    const char MAGIC[4] = {'S', 'S', 'P', '2'};
+
+    /**
+     * Appends a little-endian integer to a byte array
+     */
+    template <typename T>
+    void append(QByteArray &out, T value)
+    {
+        T little = qToLittleEndian(value);
+        out.append(reinterpret_cast<const char *>(&little), sizeof(T));
+    }
+
+    /**
+     * Reads a little-endian integer at a byte offset, the caller checks the bounds
+     */
+    template <typename T>
+    T readAt(const uchar *data, qint64 offset)
+    {
+        return qFromLittleEndian<T>(data + offset);
+    }
+
+    /**
+     * ARGB32 rows are always whole 32-bit words, so a frame's pixels are one contiguous array
+     */
+    QRgb *framePixels(QImage &frame)
+    {
+        Q_ASSERT(frame.bytesPerLine() == frame.width() * qsizetype(sizeof(QRgb)));
+        return PixelView(frame).row(0);
+    }
+}
+
+quint64 (*ProjectFile::hashPixels)(const QRgb *, qsizetype) = [](const QRgb *pixels, qsizetype count)
+{ return ContentHash::pixels(pixels, count); };
+
+bool ProjectFile::isBinary(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    return file.read(sizeof(MAGIC)) == QByteArray(MAGIC, sizeof(MAGIC));
+}
+
+bool ProjectFile::write(const QString &filePath, qsizetype frameCount, const FrameSource &frameAt, Compression compression,
+                        QString &error, const Progress &progress)
+{
+    if (frameCount <= 0)
+    {
+        error = "There are no frames to save.";
+        return false;
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        error = file.errorString();
+        return false;
+    }
+
+    QImage first = frameAt(0);
+    QByteArray header;
+    header.append(MAGIC, sizeof(MAGIC));
+    append<quint16>(header, VERSION);
+    append<quint16>(header, HEADER_SIZE);
+    append<quint32>(header, first.width());
+    append<quint32>(header, first.height());
+    append<quint32>(header, quint32(frameCount));
+    append<quint32>(header, 0);
+    file.write(header);
+
+    // Reused for every frame so a save allocates its buffers once
+    QByteArray raw;
+    QByteArray encoded;
+    QByteArray chunkHeader;
+    // First frame written with each pixel hash, and the previous frame, since held poses repeat the frame before
+    std::unordered_map<quint64, qsizetype> writtenHashes;
+    QImage previous;
+    quint64 previousHash = 0;
+    for (qsizetype i = 0; i < frameCount; i++)
+    {
+        const QImage frame = i == 0 ? std::move(first) : frameAt(i);
+        ConstPixelView pixels(frame);
+        qsizetype count = qsizetype(pixels.width()) * pixels.height();
+
+        const QByteArray *payload = &raw;
+        Compression stored = Compression::NONE;
+        if (compression == Compression::RLE)
+        {
+            // A matching hash is confirmed by comparing pixels with the very frame the reference names. A held pose
+            // is checked against the frame before, which is still in memory, then the first frame written with the
+            // hash is tried
+            quint64 hash = hashPixels(pixels.row(0), count);
+            auto written = writtenHashes.emplace(hash, i).first;
+            if (written->second != i)
+            {
+                auto samePixels = [&pixels, count](const QImage &earlier)
+                { return std::memcmp(ConstPixelView(earlier).row(0), pixels.row(0), count * sizeof(QRgb)) == 0; };
+                qsizetype target = -1;
+                if (hash == previousHash && samePixels(previous))
+                    target = i - 1;
+                else if (written->second != i - 1 && samePixels(frameAt(written->second)))
+                    target = written->second;
+                if (target >= 0)
+                {
+                    raw.clear();
+                    append<quint32>(raw, quint32(target));
+                    stored = Compression::REFERENCE;
+                }
+            }
+            previous = frame;
+            previousHash = hash;
+
+            if (stored != Compression::REFERENCE)
+            {
+                encodeRuns(pixels.row(0), count, encoded);
+                if (encoded.size() < count * qsizetype(sizeof(QRgb)))
+                {
+                    payload = &encoded;
+                    stored = Compression::RLE;
+                }
+            }
+        }
+        if (stored == Compression::NONE)
+        {
+            raw.resize(count * sizeof(QRgb));
+            qToLittleEndian<quint32>(pixels.row(0), count, raw.data());
+        }
+
+        chunkHeader.clear();
+        append<quint8>(chunkHeader, quint8(stored));
+        chunkHeader.append(3, '\0');
+        append<quint32>(chunkHeader, quint32(payload->size()));
+        file.write(chunkHeader);
+        if (file.write(*payload) != payload->size())
+        {
+            error = file.errorString();
+            return false;
+        }
+        if (progress && !progress(qint64(i) + 1, qint64(frameCount)))
+        {
+            return false;
+        }
+    }
+
+    if (!file.commit())
+    {
+        error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool ProjectFile::read(const QString &filePath, std::vector<QImage> &frames, int &size, QString &error,
+                       const Progress &progress)
+{
+    // Repeated frames share the image of the frame they repeat
+    std::vector<QImage> loaded;
+    auto collect = [&loaded](const QImage &frame, qsizetype repeats)
+    { loaded.push_back(repeats >= 0 ? loaded[size_t(repeats)] : frame); };
+    if (!read(filePath, collect, size, error, progress))
+    {
+        return false;
+    }
+    frames = std::move(loaded);
+    return true;
+}
+
+bool ProjectFile::read(const QString &filePath, const FrameSink &sink, int &size, QString &error,
+                       const Progress &progress)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        error = file.errorString();
+        return false;
+    }
+
+    // Decode straight from the page cache when the file can be mapped, otherwise read it in
+    qint64 length = file.size();
+    if (uchar *mapped = file.map(0, length))
+    {
+        bool decoded = decode(mapped, length, sink, size, error, progress);
+        file.unmap(mapped);
+        return decoded;
+    }
+    QByteArray contents = file.readAll();
+    return decode(reinterpret_cast<const uchar *>(contents.constData()), contents.size(), sink, size, error, progress);
+}
+
+bool ProjectFile::decode(const uchar *data, qint64 length, const FrameSink &sink, int &size, QString &error,
+                         const Progress &progress)
+{
+    if (length < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        error = "The file is not a binary SSP project.";
+        return false;
+    }
+
+    quint16 version = readAt<quint16>(data, 4);
+    quint16 headerSize = readAt<quint16>(data, 6);
+    quint32 width = readAt<quint32>(data, 8);
+    quint32 height = readAt<quint32>(data, 12);
+    quint32 frameCount = readAt<quint32>(data, 16);
+    if (version != VERSION || headerSize < HEADER_SIZE || headerSize > length)
+    {
+        error = "The project was saved by an unsupported version of the editor.";
+        return false;
+    }
+    if (width == 0 || width != height || width > quint32(MAX_SIZE) || frameCount == 0 ||
+        frameCount > (length - headerSize) / CHUNK_HEADER_SIZE)
+    {
+        error = "The project header is damaged.";
+        return false;
+    }
+
+    // One image is decoded into for every frame, unless the sink keeps it, then the next frame gets its own copy
+    qsizetype count = qsizetype(width) * height;
+    QImage frame(int(width), int(height), QImage::Format_ARGB32);
+
+    qint64 offset = headerSize;
+    for (quint32 i = 0; i < frameCount; i++)
+    {
+        if (length - offset < CHUNK_HEADER_SIZE)
+        {
+            error = "The project file is truncated.";
+            return false;
+        }
+        Compression compression = Compression(readAt<quint8>(data, offset));
+        quint32 payloadSize = readAt<quint32>(data, offset + 4);
+        offset += CHUNK_HEADER_SIZE;
+        if (payloadSize > length - offset)
+        {
+            error = "The project file is truncated.";
+            return false;
+        }
+
+        const uchar *payload = data + offset;
+        bool valid = false;
+        qsizetype repeats = -1;
+        if (compression == Compression::REFERENCE)
+        {
+            // The frame shares the pixels of the earlier frame it names
+            quint32 reference = payloadSize == sizeof(quint32) ? readAt<quint32>(payload, 0) : i;
+            valid = reference < i;
+            repeats = reference;
+        }
+        else
+        {
+            QRgb *pixels = framePixels(frame);
+            if (compression == Compression::NONE)
+            {
+                valid = payloadSize == count * sizeof(QRgb);
+                if (valid)
+                    qFromLittleEndian<quint32>(payload, count, pixels);
+            }
+            else if (compression == Compression::RLE)
+            {
+                valid = decodeRuns(payload, payloadSize, pixels, count);
+            }
+        }
+        if (!valid)
+        {
+            error = QString("Frame %1 of the project is damaged.").arg(i + 1);
+            return false;
+        }
+
+        sink(repeats >= 0 ? QImage() : frame, repeats);
+        offset += payloadSize;
+        if (progress && !progress(qint64(i) + 1, qint64(frameCount)))
+        {
+            return false;
+        }
+    }
+
+    size = int(width);
+    return true;
+}
+
+void ProjectFile::encodeRuns(const QRgb *pixels, qsizetype count, QByteArray &out)
+{
+    out.clear();
+    qsizetype i = 0;
+    while (i < count)
+    {
+        // Length of the run of identical pixels starting here
+        qsizetype run = 1;
+        while (i + run < count && run < MAX_TOKEN_COUNT && pixels[i + run] == pixels[i])
+            run++;
+
+        if (run >= 2)
+        {
+            append<quint16>(out, quint16(RUN_FLAG | (run - 1)));
+            append<quint32>(out, pixels[i]);
+            i += run;
+            continue;
+        }
+
+        // Gather literal pixels until the next pair of repeated pixels
+        qsizetype literal = 1;
+        while (i + literal < count && literal < MAX_TOKEN_COUNT &&
+               !(i + literal + 1 < count && pixels[i + literal] == pixels[i + literal + 1]))
+            literal++;
+
+        append<quint16>(out, quint16(literal - 1));
+        qsizetype start = out.size();
+        out.resize(start + literal * sizeof(QRgb));
+        qToLittleEndian<quint32>(pixels + i, literal, out.data() + start);
+        i += literal;
+    }
+}
+
+bool ProjectFile::decodeRuns(const uchar *data, qsizetype length, QRgb *pixels, qsizetype count)
+{
+    qsizetype in = 0;
+    qsizetype written = 0;
+    while (in < length)
+    {
+        if (length - in < qsizetype(sizeof(quint16)))
+            return false;
+        quint16 token = qFromLittleEndian<quint16>(data + in);
+        in += sizeof(quint16);
+        qsizetype tokenCount = (token & ~RUN_FLAG) + 1;
+        if (tokenCount > count - written)
+            return false;
+
+        if (token & RUN_FLAG)
+        {
+            if (length - in < qsizetype(sizeof(quint32)))
+                return false;
+            std::fill_n(pixels + written, tokenCount, qFromLittleEndian<quint32>(data + in));
+            in += sizeof(quint32);
+        }
+        else
+        {
+            if (length - in < tokenCount * qsizetype(sizeof(quint32)))
+                return false;
+            qFromLittleEndian<quint32>(data + in, tokenCount, pixels + written);
+            in += tokenCount * sizeof(quint32);
+        }
+        written += tokenCount;
+    }
+    return written == count;
+}
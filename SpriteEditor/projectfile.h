@@ -0,0 +1,145 @@
+#ifndef PROJECTFILE_H
+#define PROJECTFILE_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+#include <functional>
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Reads and writes version 2 of the .ssp project format, a binary container made of a header followed by one
+ * chunk per frame. Frames are stored as little-endian ARGB32 pixels, optionally run-length encoded, and are decoded
+ * straight from a memory mapping of the file into the frame images.
+ *
+ * Layout, all integers little-endian:
+ *   header: "SSP2", quint16 version, quint16 header size, quint32 width, quint32 height, quint32 frame count,
+ *           quint32 reserved
+ *   frame:  quint8 compression, 3 reserved bytes, quint32 payload size, payload
+ *
+ * A frame identical to an earlier one is stored as a REFERENCE chunk naming that frame instead of its pixels
+ */
+class ProjectFile
+{
+public:
+    /**
+     * @brief How the pixels of one frame chunk are stored
+     */
+    enum class Compression : quint8
+    {
+        // width * height raw pixels
+        NONE = 0,
+        // Runs of repeated pixels and literal pixels, see encodeRuns
+        RLE = 1,
+        // A quint32 index of an earlier frame with the same pixels
+        REFERENCE = 2
+    };
+
+    /**
+     * @brief Called as work proceeds with the amount done out of a total, returning false cancels the operation
+     */
+    using Progress = std::function<bool(qint64 done, qint64 total)>;
+
+    /**
+     * @brief Returns the frame at an index, so writers only need one whole frame in memory at a time
+     */
+    using FrameSource = std::function<QImage(qsizetype index)>;
+
+    /**
+     * @brief Takes each frame as soon as it is read, so readers only need one whole frame in memory at a time. A frame
+     * the file stores as a repeat of an earlier one comes as that frame's index and a null image, otherwise the index
+     * is -1. The image may be reused for the next frame once the sink returns
+     */
+    using FrameSink = std::function<void(const QImage &frame, qsizetype repeats)>;
+
+    // Largest canvas side accepted when reading, guards against corrupt headers asking for huge allocations
+    static constexpr int MAX_SIZE = 8192;
+
+    /**
+     * @brief isBinary - checks whether a file starts with the version 2 header
+     * @param filePath - the file to check
+     * @return true for a binary project, false for anything else, including legacy JSON projects
+     */
+    static bool isBinary(const QString &filePath);
+
+    /**
+     * @brief write - saves frames to a binary project file
+     * The file is written to a temporary file that only replaces the destination once it is complete
+     * @param filePath - destination file, replaced if it exists
+     * @param frameCount - number of frames to save, at least one
+     * @param frame - gives each frame to save, all ARGB32 and the same size
+     * @param compression - RLE to compress frames where that makes them smaller and store repeated frames as
+     * references, NONE to always store raw pixels
+     * @param error - set to a description of the problem when saving fails
+     * @param progress - optional, told the number of frames written after each frame
+     * @return true if the file was written, false on errors or when cancelled, leaving the destination untouched
+     */
+    static bool write(const QString &filePath, qsizetype frameCount, const FrameSource &frame, Compression compression,
+                      QString &error, const Progress &progress = {});
+
+    /**
+     * @brief read - loads every frame of a binary project file
+     * @param filePath - the file to load
+     * @param frames - filled with the decoded ARGB32 frames
+     * @param size - set to the canvas size
+     * @param error - set to a description of the problem when loading fails
+     * @param progress - optional, told the number of frames decoded after each frame
+     * @return true if the file was read, frames and size are left untouched otherwise
+     */
+    static bool read(const QString &filePath, std::vector<QImage> &frames, int &size, QString &error,
+                     const Progress &progress = {});
+
+    /**
+     * @brief read - loads a binary project file one frame at a time
+     * @param filePath - the file to load
+     * @param sink - given each frame as it is decoded, in file order
+     * @param size - set to the canvas size
+     * @param error - set to a description of the problem when loading fails
+     * @param progress - optional, told the number of frames decoded after each frame
+     * @return true if the file was read, size is left untouched otherwise and the frames given so far are of no use
+     */
+    static bool read(const QString &filePath, const FrameSink &sink, int &size, QString &error,
+                     const Progress &progress = {});
+
+    /**
+     * @brief encodeRuns - run-length encodes pixels as quint16 tokens, each followed by one repeated pixel or by a
+     * literal run of pixels
+     * @param pixels - the pixels to encode
+     * @param count - number of pixels
+     * @param out - receives the encoded bytes, replacing its contents
+     */
+    static void encodeRuns(const QRgb *pixels, qsizetype count, QByteArray &out);
+
+    /**
+     * @brief decodeRuns - decodes encodeRuns output
+     * @return false if the data is truncated or does not produce exactly count pixels
+     */
+    static bool decodeRuns(const uchar *data, qsizetype length, QRgb *pixels, qsizetype count);
+
+private:
+    friend class TestProjectFile;
+
+    static constexpr quint16 VERSION = 2;
+    static constexpr int HEADER_SIZE = 24;
+    static constexpr int CHUNK_HEADER_SIZE = 8;
+
+    // Run tokens with this bit set repeat one pixel, the rest of the token is the count minus one
+    static constexpr quint16 RUN_FLAG = 0x8000;
+    static constexpr int MAX_TOKEN_COUNT = 0x8000;
+
+    /**
+     * @brief hashPixels - hashes a frame's pixels to find repeated frames, tests replace it to force collisions
+     */
+    static quint64 (*hashPixels)(const QRgb *pixels, qsizetype count);
+
+    /**
+     * @brief decode - decodes the header and frames of a whole file held in memory
+     */
+    static bool decode(const uchar *data, qint64 length, const FrameSink &sink, int &size, QString &error,
+                       const Progress &progress);
+};
+
+#endif // PROJECTFILE_H
@@ -0,0 +1,173 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the background project saver and loader.
+ */
+
+#include "projectio.h"
+#include "legacyprojectfile.h"
+#include "projectfile.h"
+#include <QFileInfo>
+#include <QPromise>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace
+{
+    /**
+     * Reports progress to a promise as a percentage and tells the file code whether to keep going
+     */
+    template <typename T>
+    ProjectFile::Progress promiseProgress(QPromise<T> &promise)
+    {
+        return [&promise](qint64 done, qint64 total)
+        {
+            if (total > 0)
+                promise.setProgressValue(int(done * 100 / total));
+            return !promise.isCanceled();
+        };
+    }
+}
+
+ProjectIO::ProjectIO(QObject *parent) : QObject(parent)
+{
+    connect(&watcher, &QFutureWatcher<Result>::progressValueChanged, this, &ProjectIO::progressChanged);
+    connect(&watcher, &QFutureWatcher<Result>::finished, this, &ProjectIO::operationFinished);
+}
+
+ProjectIO::~ProjectIO()
+{
+    // The worker only touches its own copies, but must not outlive the watcher following it. A save is let finish
+    // so closing never throws away a file the user asked for, a load is of no use any more
+    watcher.disconnect(this);
+    if (loading)
+        cancel();
+    watcher.waitForFinished();
+}
+
+bool ProjectIO::isBusy() const
+{
+    return watcher.isRunning();
+}
+
+bool ProjectIO::isSaving() const
+{
+    return isBusy() && !loading;
+}
+
+bool ProjectIO::finishSave()
+{
+    Q_ASSERT(isSaving());
+    watcher.waitForFinished();
+    return !watcher.isCanceled() && watcher.future().resultCount() > 0 && watcher.future().resultAt(0).ok;
+}
+
+void ProjectIO::save(const QString &filePath, std::vector<TiledFrame> snapshot, Format format)
+{
+    Q_ASSERT(!isBusy());
+    loading = false;
+    emit started("Saving " + QFileInfo(filePath).fileName());
+
+    watcher.setFuture(QtConcurrent::run(
+        [filePath, snapshot = std::move(snapshot), format](QPromise<Result> &promise)
+        {
+            promise.setProgressRange(0, 100);
+            Result result;
+            // Frames are assembled from their tiles one at a time as the writer reaches them
+            qsizetype count = qsizetype(snapshot.size());
+            auto frameAt = [&snapshot](qsizetype index)
+            { return snapshot[size_t(index)].toImage(); };
+            if (format == Format::LEGACY_JSON)
+                result.ok = LegacyProjectFile::write(filePath, count, frameAt, result.error, promiseProgress(promise));
+            else
+                result.ok = ProjectFile::write(filePath, count, frameAt, ProjectFile::Compression::RLE, result.error,
+                                               promiseProgress(promise));
+            promise.addResult(std::move(result));
+        }));
+}
+
+void ProjectIO::load(const QString &filePath, qint64 budget, FramePager pager)
+{
+    Q_ASSERT(!isBusy());
+    loading = true;
+    loadedFrames.clear();
+    emit started("Loading " + QFileInfo(filePath).fileName());
+
+    watcher.setFuture(QtConcurrent::run(
+        [filePath, budget, pager](QPromise<Result> &promise) mutable
+        {
+            promise.setProgressRange(0, 100);
+            Result result;
+            std::vector<TiledFrame> &frames = result.frames;
+
+            // Each frame is tiled as soon as it is decoded, frames the file stored as references share the tiles of
+            // the frame they repeat. Once the frames outgrow the memory budget the earliest ones are packed and then
+            // paged out, like Model::enforceFrameBudget does, so a project never has to fit in memory as images. The
+            // first frame is the one the editor opens, it stays tiled
+            qint64 bytes = 0;
+            size_t packed = 1;
+            size_t paged = 1;
+            auto sink = [&](const QImage &image, qsizetype repeats)
+            {
+                if (repeats >= 0)
+                {
+                    frames.push_back(frames[size_t(repeats)]);
+                    return;
+                }
+                frames.emplace_back(image);
+                bytes += TiledFrame::usage({frames.back()}).bytes;
+                if (budget <= 0)
+                    return;
+                while (bytes > budget && packed < frames.size())
+                    bytes -= frames[packed++].pack();
+                while (bytes > budget && paged < packed)
+                    bytes -= frames[paged++].pageOut(pager);
+            };
+
+            // Binary projects start with a header, anything else is read as a legacy JSON project
+            int size = 0;
+            if (ProjectFile::isBinary(filePath))
+                result.ok = ProjectFile::read(filePath, sink, size, result.error, promiseProgress(promise));
+            else
+                result.ok = LegacyProjectFile::read(filePath, sink, size, result.error, promiseProgress(promise));
+
+            // Repeated tiles the file did not store as references are merged once every frame is in
+            if (result.ok)
+                TiledFrame::shareTiles(frames);
+            else
+                frames.clear();
+            promise.addResult(std::move(result));
+        }));
+}
+
+std::vector<TiledFrame> ProjectIO::takeLoadedFrames()
+{
+    return std::move(loadedFrames);
+}
+
+void ProjectIO::cancel()
+{
+    if (isBusy())
+        watcher.cancel();
+}
+
+void ProjectIO::operationFinished()
+{
+    // A cancelled operation drops its result, which is reported as a failure without a message
+    Result result;
+    if (!watcher.isCanceled() && watcher.future().resultCount() > 0)
+        result = watcher.future().takeResult();
+    if (!result.ok && watcher.isCanceled())
+        result.error.clear();
+
+    if (loading)
+    {
+        if (result.ok)
+            loadedFrames = std::move(result.frames);
+        emit loadFinished(result.ok, result.error);
+    }
+    else
+    {
+        emit saveFinished(result.ok, result.error);
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef PROJECTIO_H
+#define PROJECTIO_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QString>
+#include "tiledframe.h"
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Runs project saves and loads on a worker thread so the editor stays usable. Saves encode an immutable
+ * snapshot of the frames, progress is reported as a percentage and the running operation can be cancelled.
+ * Only one operation runs at a time
+ */
+class ProjectIO : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief The file formats a project can be saved in
+     */
+    enum class Format
+    {
+        BINARY,
+        LEGACY_JSON
+    };
+
+    /**
+     * @brief ProjectIO - creates an idle worker
+     * @param parent - owner of the worker
+     */
+    explicit ProjectIO(QObject *parent = nullptr);
+
+    /**
+     * Waits for a running save to finish and cancels a running load
+     */
+    ~ProjectIO();
+
+    /**
+     * @brief isBusy - returns true while a save or load is running
+     */
+    bool isBusy() const;
+
+    /**
+     * @brief isSaving - returns true while a save is running
+     */
+    bool isSaving() const;
+
+    /**
+     * @brief finishSave - blocks until the running save ends, for when the editor closes and cannot wait for
+     * saveFinished
+     * @return true if the save wrote its file
+     */
+    bool finishSave();
+
+    /**
+     * @brief save - starts saving frames in the background, saveFinished is emitted when it ends
+     * The destination is only replaced once the whole file was written
+     * @param filePath - destination file
+     * @param snapshot - the frames to save, copies sharing their tiles so later edits do not affect the save
+     * @param format - the file format
+     */
+    void save(const QString &filePath, std::vector<TiledFrame> snapshot, Format format);
+
+    /**
+     * @brief load - starts loading a binary or legacy JSON project in the background, loadFinished is emitted when it
+     * ends and the frames can then be taken with takeLoadedFrames
+     * Frames are tiled as they are read and packed or paged out once they outgrow the budget
+     * @param filePath - the project file
+     * @param budget - the most bytes the loaded frames should use, 0 for no limit
+     * @param pager - a copy of the editor's pager, sharing its scratch file, for frames that do not fit the budget
+     */
+    void load(const QString &filePath, qint64 budget, FramePager pager);
+
+    /**
+     * @brief takeLoadedFrames - returns the frames of the last successful load, leaving none behind
+     */
+    std::vector<TiledFrame> takeLoadedFrames();
+
+public slots:
+    /**
+     * @brief cancel - asks the running operation to stop, it then finishes without an error message
+     */
+    void cancel();
+
+signals:
+    /**
+     * Emitted when an operation starts.
+     * @param description Text describing the operation for the user.
+     */
+    void started(const QString &description);
+
+    /**
+     * Emitted as the running operation makes progress.
+     * @param percent How much of the operation is done, from 0 to 100.
+     */
+    void progressChanged(int percent);
+
+    /**
+     * Emitted when a save ends.
+     * @param ok True if the file was written.
+     * @param error A description of the problem, empty if the save succeeded or was cancelled.
+     */
+    void saveFinished(bool ok, const QString &error);
+
+    /**
+     * Emitted when a load ends.
+     * @param ok True if the frames were loaded.
+     * @param error A description of the problem, empty if the load succeeded or was cancelled.
+     */
+    void loadFinished(bool ok, const QString &error);
+
+private slots:
+    /**
+     * @brief operationFinished - collects the worker's result and reports it
+     */
+    void operationFinished();
+
+private:
+    /**
+     * @brief What a worker hands back to the GUI thread
+     */
+    struct Result
+    {
+        bool ok = false;
+        QString error;
+        std::vector<TiledFrame> frames;
+    };
+
+    /**
+     * @brief watcher - follows the running operation, reporting its progress and completion on the GUI thread
+     */
+    QFutureWatcher<Result> watcher;
+
+    /**
+     * @brief loading - true if the running or last operation is a load
+     */
+    bool loading = false;
+
+    /**
+     * @brief loadedFrames - frames of the last successful load, until they are taken
+     */
+    std::vector<TiledFrame> loadedFrames;
+};
+
+#endif // PROJECTIO_H
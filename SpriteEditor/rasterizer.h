@@ -0,0 +1,178 @@
+#ifndef RASTERIZER_H
+#define RASTERIZER_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Integer rasterization of the lines and shapes the drawing tools are made of. Primitives are reported as
+ * horizontal spans so callers can write a whole run of a scanline at once
+ */
+class Rasterizer
+{
+public:
+    /**
+     * @brief line - visits every pixel of the Bresenham line between two points, both ends included
+     * @param x0 - x coordinate of the start point
+     * @param y0 - y coordinate of the start point
+     * @param x1 - x coordinate of the end point
+     * @param y1 - y coordinate of the end point
+     * @param plot - called as plot(x, y) for each pixel, in order from the start point
+     */
+    template <typename Plot>
+    static void line(int x0, int y0, int x1, int y1, Plot &&plot)
+    {
+        int dx = std::abs(x1 - x0), stepX = x0 < x1 ? 1 : -1;
+        int dy = -std::abs(y1 - y0), stepY = y0 < y1 ? 1 : -1;
+        int error = dx + dy;
+        while (true)
+        {
+            plot(x0, y0);
+            if (x0 == x1 && y0 == y1)
+                break;
+            int doubled = 2 * error;
+            if (doubled >= dy)
+            {
+                error += dy;
+                x0 += stepX;
+            }
+            if (doubled <= dx)
+            {
+                error += dx;
+                y0 += stepY;
+            }
+        }
+    }
+
+    /**
+     * @brief lineSpans - the same pixels as line, merged into horizontal runs
+     * @param span - called as span(y, left, right) for each run, right is inclusive
+     */
+    template <typename Span>
+    static void lineSpans(int x0, int y0, int x1, int y1, Span &&span)
+    {
+        bool open = false;
+        int runY = 0, runLeft = 0, runRight = 0;
+        line(x0, y0, x1, y1, [&](int x, int y)
+             {
+                 // Extend the current run while the line stays on the same row
+                 if (open && y == runY && (x == runRight + 1 || x == runLeft - 1))
+                 {
+                     runLeft = std::min(runLeft, x);
+                     runRight = std::max(runRight, x);
+                     return;
+                 }
+                 if (open)
+                     span(runY, runLeft, runRight);
+                 open = true;
+                 runY = y;
+                 runLeft = runRight = x;
+             });
+        if (open)
+            span(runY, runLeft, runRight);
+    }
+
+    /**
+     * @brief rectSpans - the rectangle with corners at two points, both corners included
+     * @param filled - true for the whole area, false for a one pixel outline
+     */
+    template <typename Span>
+    static void rectSpans(int x0, int y0, int x1, int y1, bool filled, Span &&span)
+    {
+        int left = std::min(x0, x1), right = std::max(x0, x1);
+        int top = std::min(y0, y1), bottom = std::max(y0, y1);
+        for (int y = top; y <= bottom; y++)
+        {
+            if (filled || y == top || y == bottom || right - left <= 1)
+            {
+                span(y, left, right);
+            }
+            else
+            {
+                span(y, left, left);
+                span(y, right, right);
+            }
+        }
+    }
+
+    /**
+     * @brief ellipseSpans - the midpoint ellipse inscribed in the rectangle with corners at two points
+     * Works for odd and even sizes, each row is reported once when filled and as its left and right runs (or one
+     * merged run where they meet) for the outline
+     * @param filled - true for the whole area, false for a one pixel outline
+     */
+    template <typename Span>
+    static void ellipseSpans(int x0, int y0, int x1, int y1, bool filled, Span &&span)
+    {
+        int left = std::min(x0, x1), right = std::max(x0, x1);
+        int top = std::min(y0, y1), bottom = std::max(y0, y1);
+
+        // Extent of the left half of the outline on every row, the right half mirrors it
+        int rows = bottom - top + 1;
+        std::vector<int> outerX(rows, right + 1), innerX(rows, left - 1);
+        auto plot = [&](int x, int y)
+        {
+            if (y < top || y > bottom)
+                return;
+            outerX[y - top] = std::min(outerX[y - top], x);
+            innerX[y - top] = std::max(innerX[y - top], x);
+        };
+
+        // Bresenham-style ellipse walk over both halves at once, using 64-bit error terms
+        long long a = right - left, b = bottom - top, b1 = b & 1;
+        long long dx = 4 * (1 - a) * b * b, dy = 4 * (b1 + 1) * a * a;
+        long long error = dx + dy + b1 * a * a;
+        int xLeft = left, xRight = right;
+        int yLow = top + int((b + 1) / 2), yHigh = yLow - int(b1);
+        a *= 8 * a;
+        b1 = 8 * b * b;
+        do
+        {
+            plot(xLeft, yLow);
+            plot(xLeft, yHigh);
+            long long doubled = 2 * error;
+            if (doubled <= dy)
+            {
+                yLow++;
+                yHigh--;
+                error += dy += a;
+            }
+            if (doubled >= dx || 2 * error > dy)
+            {
+                xLeft++;
+                xRight--;
+                error += dx += b1;
+            }
+        } while (xLeft <= xRight);
+
+        // Very flat ellipses stop early, finish their tips
+        while (yLow - yHigh <= b)
+        {
+            plot(xLeft - 1, yLow++);
+            plot(xLeft - 1, yHigh--);
+        }
+
+        for (int row = 0; row < rows; row++)
+        {
+            if (outerX[row] > innerX[row])
+                continue;
+            int mirroredInner = left + right - innerX[row];
+            int mirroredOuter = left + right - outerX[row];
+            if (filled || innerX[row] + 1 >= mirroredInner)
+            {
+                span(top + row, outerX[row], mirroredOuter);
+            }
+            else
+            {
+                span(top + row, outerX[row], innerX[row]);
+                span(top + row, mirroredInner, mirroredOuter);
+            }
+        }
+    }
+};
+
+#endif // RASTERIZER_H
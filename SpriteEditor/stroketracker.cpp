@@ -0,0 +1,27 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the stroke tracker.
+ */
+
+#include "stroketracker.h"
+
+void StrokeTracker::resize(int width, int height)
+{
+    tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    int tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    bits.assign(size_t(tilesX) * tilesY * TILE_SIZE, 0);
+    touched.assign(size_t(tilesX) * tilesY, 0);
+    touchedTiles.clear();
+}
+
+void StrokeTracker::clear()
+{
+    for (int tile : touchedTiles)
+    {
+        std::fill_n(bits.begin() + size_t(tile) * TILE_SIZE, TILE_SIZE, 0);
+        touched[tile] = 0;
+    }
+    touchedTiles.clear();
+}
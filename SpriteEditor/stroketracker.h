@@ -0,0 +1,129 @@
+#ifndef STROKETRACKER_H
+#define STROKETRACKER_H
+
+#include <QtGlobal>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Remembers which canvas pixels the current stroke has already painted, so overlapping stamps blend each pixel
+ * once. Pixels are stored as one bit each in 32x32 tiles, and only the tiles a stroke touched are cleared when it ends
+ */
+class StrokeTracker
+{
+public:
+    /**
+     * @brief resize - sets the canvas size and forgets every visited pixel
+     * @param width - canvas width in pixels
+     * @param height - canvas height in pixels
+     */
+    void resize(int width, int height);
+
+    /**
+     * @brief clear - forgets the pixels visited by the current stroke, costing only the tiles it touched
+     */
+    void clear();
+
+    /**
+     * @brief visitSpan - marks a span of one row as visited and reports the parts that were not visited before
+     * Adjacent parts are merged across tile boundaries
+     * @param y - the row, must be on the canvas
+     * @param left - first column of the span, must be on the canvas
+     * @param right - one past the last column of the span, at most the canvas width
+     * @param run - called as run(start, end) for each newly visited part, end is exclusive
+     */
+    template <typename Run>
+    void visitSpan(int y, int left, int right, Run &&run)
+    {
+        int tileRow = y / TILE_SIZE;
+        int rowInTile = y % TILE_SIZE;
+        int runStart = -1, runEnd = -1;
+
+        int x = left;
+        while (x < right)
+        {
+            int tileColumn = x / TILE_SIZE;
+            int tileLeft = tileColumn * TILE_SIZE;
+            int tile = tileRow * tilesX + tileColumn;
+            int bit = x - tileLeft;
+            int end = std::min(right, tileLeft + TILE_SIZE) - tileLeft;
+
+            quint32 &word = bits[tile * TILE_SIZE + rowInTile];
+            quint32 fresh = spanMask(bit, end) & ~word;
+            if (fresh)
+            {
+                word |= fresh;
+                touch(tile);
+            }
+
+            // Walk the alternating runs of fresh and already visited pixels
+            while (bit < end)
+            {
+                quint32 remaining = fresh >> bit;
+                if (remaining & 1)
+                {
+                    int length = std::min(int(qCountTrailingZeroBits(quint32(~remaining))), end - bit);
+                    if (runStart < 0)
+                        runStart = tileLeft + bit;
+                    bit += length;
+                    runEnd = tileLeft + bit;
+                }
+                else
+                {
+                    int gap = remaining ? int(qCountTrailingZeroBits(remaining)) : end - bit;
+                    if (runStart >= 0)
+                    {
+                        run(runStart, runEnd);
+                        runStart = -1;
+                    }
+                    bit += std::min(gap, end - bit);
+                }
+            }
+            x = tileLeft + end;
+        }
+
+        if (runStart >= 0)
+            run(runStart, runEnd);
+    }
+
+private:
+    static constexpr int TILE_SIZE = 32;
+
+    /**
+     * @brief spanMask - the bits from first up to but not including last
+     */
+    static quint32 spanMask(int first, int last)
+    {
+        quint32 upTo = last >= TILE_SIZE ? ~quint32(0) : (quint32(1) << last) - 1;
+        return upTo & ~((quint32(1) << first) - 1);
+    }
+
+    /**
+     * @brief touch - records that a tile holds visited pixels
+     */
+    void touch(int tile)
+    {
+        if (!touched[tile])
+        {
+            touched[tile] = 1;
+            touchedTiles.push_back(tile);
+        }
+    }
+
+    int tilesX = 0;
+
+    // Tile-major bits, each tile is TILE_SIZE words with one word per row and one bit per column
+    std::vector<quint32> bits;
+
+    // Whether each tile is in touchedTiles
+    std::vector<quint8> touched;
+
+    // The tiles visited since the last clear
+    std::vector<int> touchedTiles;
+};
+
+#endif // STROKETRACKER_H
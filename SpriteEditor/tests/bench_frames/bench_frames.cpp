@@ -0,0 +1,373 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Benchmarks of frame transforms and project saving, after a check that the transforms match a naive remap.
+ * Every benchmark has a row running the editor's original pixelColor or QJsonDocument code next to the rows running
+ * the current code, so the gain shows in one run.
+ */
+
+#include <QColor>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <vector>
+#include "legacyprojectfile.h"
+#include "projectfile.h"
+#include "transforms.h"
+
+Q_DECLARE_METATYPE(FrameTransform::Operation)
+
+namespace
+{
+    // Width and height of the benchmark frames, and how many frames the whole-animation benchmarks use
+    const int FRAME_SIZE = 256;
+    const int FRAME_COUNT = 64;
+
+    /**
+     * The ways a benchmark row can do its work
+     */
+    enum class Method
+    {
+        // The code the editor started with
+        ORIGINAL,
+        FRAME_TRANSFORM,
+        LEGACY_JSON,
+        BINARY,
+        BINARY_RLE
+    };
+
+    /**
+     * A sprite-like frame: colored blocks on a transparent background, some of them half transparent
+     */
+    QImage makeFrame(quint32 seed)
+    {
+        QRandomGenerator random(seed);
+        QImage frame(FRAME_SIZE, FRAME_SIZE, QImage::Format_ARGB32);
+        frame.fill(0);
+        for (int block = 0; block < 40; block++)
+        {
+            int left = random.bounded(FRAME_SIZE - 16);
+            int top = random.bounded(FRAME_SIZE - 16);
+            QRgb color = qRgba(random.bounded(256), random.bounded(256), random.bounded(256),
+                               random.bounded(2) ? 255 : 128);
+            for (int y = top; y < top + 16; y++)
+            {
+                for (int x = left; x < left + 16; x++)
+                    frame.setPixel(x, y, color);
+            }
+        }
+        return frame;
+    }
+
+    /**
+     * An animation in which every other frame holds the pose of the one before
+     */
+    std::vector<QImage> makeAnimation()
+    {
+        std::vector<QImage> frames;
+        for (int i = 0; i < FRAME_COUNT; i++)
+            frames.push_back(i % 2 == 1 ? frames.back().copy() : makeFrame(quint32(i)));
+        return frames;
+    }
+
+    /**
+     * Random pixels of any size, so the SSE2 blocks and the transpose tiles both get partial edges
+     */
+    QImage makeNoise(int width, int height, quint32 seed)
+    {
+        QRandomGenerator random(seed);
+        QImage image(width, height, QImage::Format_ARGB32);
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+                image.setPixel(x, y, random.generate());
+        }
+        return image;
+    }
+
+    /**
+     * An operation done the naive way, reading every destination pixel from its source position
+     */
+    QImage remap(const QImage &image, FrameTransform::Operation operation)
+    {
+        int width = image.width();
+        int height = image.height();
+        bool quarterTurn = operation == FrameTransform::Operation::ROTATE_90 ||
+                           operation == FrameTransform::Operation::ROTATE_270 ||
+                           operation == FrameTransform::Operation::TRANSPOSE;
+        QImage result(quarterTurn ? height : width, quarterTurn ? width : height, QImage::Format_ARGB32);
+        for (int y = 0; y < result.height(); y++)
+        {
+            for (int x = 0; x < result.width(); x++)
+            {
+                QPoint source;
+                switch (operation)
+                {
+                case FrameTransform::Operation::FLIP_HORIZONTAL:
+                    source = QPoint(width - 1 - x, y);
+                    break;
+                case FrameTransform::Operation::FLIP_VERTICAL:
+                    source = QPoint(x, height - 1 - y);
+                    break;
+                case FrameTransform::Operation::ROTATE_90:
+                    source = QPoint(y, height - 1 - x);
+                    break;
+                case FrameTransform::Operation::ROTATE_180:
+                    source = QPoint(width - 1 - x, height - 1 - y);
+                    break;
+                case FrameTransform::Operation::ROTATE_270:
+                    source = QPoint(width - 1 - y, x);
+                    break;
+                case FrameTransform::Operation::TRANSPOSE:
+                    source = QPoint(y, x);
+                    break;
+                }
+                result.setPixel(x, y, image.pixel(source));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Model::mirrorFrame and Model::rotateFrame as they first were, through a copy and pixelColor/setPixelColor
+     */
+    void originalTransform(QImage &image, FrameTransform::Operation operation)
+    {
+        int size = image.width();
+        QImage temp = image.copy();
+        for (int i = 0; i < size; i++)
+        {
+            for (int j = 0; j < size; j++)
+            {
+                if (operation == FrameTransform::Operation::FLIP_HORIZONTAL)
+                    image.setPixelColor(i, j, temp.pixelColor(size - 1 - i, j));
+                else
+                    image.setPixelColor(i, j, temp.pixelColor(j, size - 1 - i));
+            }
+        }
+    }
+
+    /**
+     * Model::saveProject as it first was, building the whole QJsonDocument before writing it
+     */
+    bool originalSave(const QString &filePath, const std::vector<QImage> &frames)
+    {
+        int width = frames.front().width();
+        QJsonObject json;
+        json["width"] = width;
+        json["frameCount"] = int(frames.size());
+
+        QJsonArray frameData;
+        for (const QImage &frame : frames)
+        {
+            QJsonArray singleFrame;
+            for (int y = 0; y < width; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    QColor color = frame.pixelColor(x, y);
+                    singleFrame.append(color.red());
+                    singleFrame.append(color.green());
+                    singleFrame.append(color.blue());
+                    singleFrame.append(color.alpha());
+                }
+            }
+            frameData.append(singleFrame);
+        }
+        json["frames"] = frameData;
+
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+        return file.write(QJsonDocument(json).toJson()) > 0;
+    }
+}
+
+Q_DECLARE_METATYPE(Method)
+
+class BenchFrames : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void transformMatchesRemap_data();
+
+    /**
+     * Every operation gives the same pixels as the naive remap, on square and non-square sizes that are and are not
+     * multiples of the SSE2 block and transpose tile sizes
+     */
+    void transformMatchesRemap();
+
+    void transformOne_data();
+
+    /**
+     * Mirrors or rotates the frame being edited
+     */
+    void transformOne();
+
+    void transformAll_data();
+
+    /**
+     * Mirrors or rotates every frame of the animation
+     */
+    void transformAll();
+
+    void save_data();
+
+    /**
+     * Saves the animation in each format
+     */
+    void save();
+
+private:
+    void addTransformRows();
+};
+
+void BenchFrames::addTransformRows()
+{
+    QTest::addColumn<FrameTransform::Operation>("operation");
+    QTest::addColumn<Method>("method");
+    QTest::newRow("mirror original") << FrameTransform::Operation::FLIP_HORIZONTAL << Method::ORIGINAL;
+    QTest::newRow("mirror") << FrameTransform::Operation::FLIP_HORIZONTAL << Method::FRAME_TRANSFORM;
+    QTest::newRow("rotate original") << FrameTransform::Operation::ROTATE_90 << Method::ORIGINAL;
+    QTest::newRow("rotate") << FrameTransform::Operation::ROTATE_90 << Method::FRAME_TRANSFORM;
+}
+
+void BenchFrames::transformMatchesRemap_data()
+{
+    QTest::addColumn<FrameTransform::Operation>("operation");
+    QTest::addColumn<QSize>("size");
+    const std::pair<const char *, FrameTransform::Operation> operations[] = {
+        {"flip horizontal", FrameTransform::Operation::FLIP_HORIZONTAL},
+        {"flip vertical", FrameTransform::Operation::FLIP_VERTICAL},
+        {"rotate 90", FrameTransform::Operation::ROTATE_90},
+        {"rotate 180", FrameTransform::Operation::ROTATE_180},
+        {"rotate 270", FrameTransform::Operation::ROTATE_270},
+        {"transpose", FrameTransform::Operation::TRANSPOSE}};
+    const QSize sizes[] = {QSize(1, 1), QSize(3, 3), QSize(7, 5), QSize(31, 33), QSize(64, 64),
+                           QSize(67, 67), QSize(96, 40), QSize(13, 130), QSize(FRAME_SIZE, FRAME_SIZE)};
+    for (const auto &[name, operation] : operations)
+    {
+        for (QSize size : sizes)
+            QTest::addRow("%s %dx%d", name, size.width(), size.height()) << operation << size;
+    }
+}
+
+void BenchFrames::transformMatchesRemap()
+{
+    QFETCH(FrameTransform::Operation, operation);
+    QFETCH(QSize, size);
+
+    QImage image = makeNoise(size.width(), size.height(), quint32(size.width() * 1000 + size.height()));
+    QImage expected = remap(image, operation);
+
+    QImage transformed = image.copy();
+    FrameTransform::apply(transformed, operation);
+    QCOMPARE(transformed, expected);
+
+    // The whole-animation path transforms each frame on its own thread, frames of other sizes must not interfere
+    std::vector<QImage> frames = {image.copy(), makeNoise(5, 9, 1), image.copy()};
+    FrameTransform::applyToAll(frames, operation);
+    QCOMPARE(frames[0], expected);
+    QCOMPARE(frames[1], remap(makeNoise(5, 9, 1), operation));
+    QCOMPARE(frames[2], expected);
+}
+
+void BenchFrames::transformOne_data()
+{
+    addTransformRows();
+}
+
+void BenchFrames::transformOne()
+{
+    QFETCH(FrameTransform::Operation, operation);
+    QFETCH(Method, method);
+
+    QImage frame = makeFrame(0);
+    QBENCHMARK
+    {
+        if (method == Method::ORIGINAL)
+            originalTransform(frame, operation);
+        else
+            FrameTransform::apply(frame, operation);
+    }
+}
+
+void BenchFrames::transformAll_data()
+{
+    addTransformRows();
+}
+
+void BenchFrames::transformAll()
+{
+    QFETCH(FrameTransform::Operation, operation);
+    QFETCH(Method, method);
+
+    std::vector<QImage> frames = makeAnimation();
+    QBENCHMARK
+    {
+        if (method == Method::ORIGINAL)
+        {
+            for (QImage &frame : frames)
+                originalTransform(frame, operation);
+        }
+        else
+        {
+            FrameTransform::applyToAll(frames, operation);
+        }
+    }
+}
+
+void BenchFrames::save_data()
+{
+    QTest::addColumn<Method>("method");
+    QTest::newRow("json original") << Method::ORIGINAL;
+    QTest::newRow("json") << Method::LEGACY_JSON;
+    QTest::newRow("binary") << Method::BINARY;
+    QTest::newRow("binary rle") << Method::BINARY_RLE;
+}
+
+void BenchFrames::save()
+{
+    QFETCH(Method, method);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString filePath = directory.filePath("animation.ssp");
+    std::vector<QImage> frames = makeAnimation();
+    auto frameAt = [&frames](qsizetype index)
+    { return frames[size_t(index)]; };
+
+    bool saved = false;
+    QString error;
+    QBENCHMARK
+    {
+        switch (method)
+        {
+        case Method::ORIGINAL:
+            saved = originalSave(filePath, frames);
+            break;
+        case Method::LEGACY_JSON:
+            saved = LegacyProjectFile::write(filePath, qsizetype(frames.size()), frameAt, error);
+            break;
+        case Method::BINARY:
+            saved = ProjectFile::write(filePath, qsizetype(frames.size()), frameAt, ProjectFile::Compression::NONE,
+                                       error);
+            break;
+        default:
+            saved = ProjectFile::write(filePath, qsizetype(frames.size()), frameAt, ProjectFile::Compression::RLE,
+                                       error);
+            break;
+        }
+    }
+    QVERIFY2(saved, qPrintable(error));
+}
+
+QTEST_APPLESS_MAIN(BenchFrames)
+
+#include "bench_frames.moc"
@@ -0,0 +1,22 @@
+QT += testlib concurrent
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+TARGET = bench_frames
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../legacyprojectfile.cpp \
+    ../../projectfile.cpp \
+    ../../transforms.cpp \
+    bench_frames.cpp
+
+HEADERS += \
+    ../../contenthash.h \
+    ../../legacyprojectfile.h \
+    ../../pixelview.h \
+    ../../projectfile.h \
+    ../../transforms.h
@@ -0,0 +1,7 @@
+# Unit tests and benchmarks, built and run with: qmake tests.pro && make check
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    bench_frames \
+    tst_blend \
+    tst_projectfile
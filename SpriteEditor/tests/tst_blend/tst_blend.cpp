@@ -0,0 +1,193 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Checks every blend kernel against the editor's original integer formula, over all 8-bit inputs.
+ */
+
+#include <QRandomGenerator>
+#include <QtTest>
+#include <vector>
+#include "blend.h"
+
+Q_DECLARE_METATYPE(Blend::Path)
+
+namespace
+{
+    // Source alphas covered by one row of the exhaustive test
+    const int ALPHA_STEP = 64;
+
+    /**
+     * The formula Model::blendAdditive used, written out on integers. A channel above 255 made an invalid QColor,
+     * which setPixelColor ignored, so the destination kept its color
+     */
+    QRgb originalBlend(QRgb src, QRgb dst)
+    {
+        if (dst == 0)
+            return src;
+
+        int redDest = qRed(dst), greenDest = qGreen(dst), blueDest = qBlue(dst), alphaDest = qAlpha(dst);
+        int redSrc = qRed(src), greenSrc = qGreen(src), blueSrc = qBlue(src), alphaSrc = qAlpha(src);
+
+        int alphaOverride = alphaSrc + alphaDest * (255 - alphaSrc) / 255;
+        if (alphaOverride == 0)
+            return 0;
+
+        int redOverride = (redSrc * alphaSrc + redDest * alphaDest * (255 - alphaSrc) / 255) / alphaOverride;
+        int greenOverride = (greenSrc * alphaSrc + greenDest * alphaDest * (255 - alphaSrc) / 255) / alphaOverride;
+        int blueOverride = (blueSrc * alphaSrc + blueDest * alphaDest * (255 - alphaSrc) / 255) / alphaOverride;
+        if (redOverride > 255 || greenOverride > 255 || blueOverride > 255)
+            return dst;
+
+        return qRgba(redOverride, greenOverride, blueOverride, alphaOverride);
+    }
+
+    /**
+     * Blends src over dst with a kernel and compares every pixel with the original formula
+     */
+    bool matchesFormula(Blend::Path path, const std::vector<QRgb> &src, const std::vector<QRgb> &dst, QString &error)
+    {
+        std::vector<QRgb> blended = dst;
+        Blend::span(path, blended.data(), src.data(), int(src.size()));
+        for (size_t i = 0; i < src.size(); i++)
+        {
+            QRgb expected = originalBlend(src[i], dst[i]);
+            if (blended[i] != expected)
+            {
+                error = QString("src %1 over dst %2 gave %3, expected %4")
+                            .arg(src[i], 8, 16, QChar('0'))
+                            .arg(dst[i], 8, 16, QChar('0'))
+                            .arg(blended[i], 8, 16, QChar('0'))
+                            .arg(expected, 8, 16, QChar('0'));
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+class TestBlend : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void allInputs_data();
+
+    /**
+     * Every source and destination channel value under every source and destination alpha, 2^32 pixels per path
+     */
+    void allInputs();
+
+    void mixedChannels_data();
+
+    /**
+     * Random pixels whose channels differ, in a span whose length leaves a tail for the scalar loop
+     */
+    void mixedChannels();
+
+    /**
+     * A solid color blended over a span gives the same pixels as blending it one pixel at a time
+     */
+    void solidSpan();
+
+private:
+    void addPaths();
+};
+
+void TestBlend::addPaths()
+{
+    QTest::addColumn<Blend::Path>("path");
+    QTest::newRow("scalar") << Blend::Path::SCALAR;
+    QTest::newRow("sse2") << Blend::Path::SSE2;
+    QTest::newRow("avx2") << Blend::Path::AVX2;
+}
+
+void TestBlend::allInputs_data()
+{
+    // Each path is split by source alpha, so no single row runs into the test function timeout
+    QTest::addColumn<Blend::Path>("path");
+    QTest::addColumn<int>("firstAlpha");
+    const std::pair<const char *, Blend::Path> paths[] = {
+        {"scalar", Blend::Path::SCALAR}, {"sse2", Blend::Path::SSE2}, {"avx2", Blend::Path::AVX2}};
+    for (const auto &[name, path] : paths)
+    {
+        for (int firstAlpha = 0; firstAlpha < 256; firstAlpha += ALPHA_STEP)
+            QTest::addRow("%s alpha %d-%d", name, firstAlpha, firstAlpha + ALPHA_STEP - 1) << path << firstAlpha;
+    }
+}
+
+void TestBlend::allInputs()
+{
+    QFETCH(Blend::Path, path);
+    QFETCH(int, firstAlpha);
+    if (!Blend::isSupported(path))
+        QSKIP("This build or CPU has no such kernel");
+
+    // One span per alpha pair holds every pair of channel values, on gray pixels so all three channels are checked
+    std::vector<QRgb> src(256 * 256);
+    std::vector<QRgb> dst(256 * 256);
+    QString error;
+    for (int alphaSrc = firstAlpha; alphaSrc < firstAlpha + ALPHA_STEP; alphaSrc++)
+    {
+        for (int alphaDest = 0; alphaDest < 256; alphaDest++)
+        {
+            for (int channelSrc = 0; channelSrc < 256; channelSrc++)
+            {
+                for (int channelDest = 0; channelDest < 256; channelDest++)
+                {
+                    src[channelSrc * 256 + channelDest] = qRgba(channelSrc, channelSrc, channelSrc, alphaSrc);
+                    dst[channelSrc * 256 + channelDest] = qRgba(channelDest, channelDest, channelDest, alphaDest);
+                }
+            }
+            if (!matchesFormula(path, src, dst, error))
+                QFAIL(qPrintable(error));
+        }
+    }
+}
+
+void TestBlend::mixedChannels_data()
+{
+    addPaths();
+}
+
+void TestBlend::mixedChannels()
+{
+    QFETCH(Blend::Path, path);
+    if (!Blend::isSupported(path))
+        QSKIP("This build or CPU has no such kernel");
+
+    QRandomGenerator random(3505);
+    std::vector<QRgb> src(1000003);
+    std::vector<QRgb> dst(src.size());
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        src[i] = random.generate();
+        // Empty destinations take the source as is, some are needed inside the vector blocks too
+        dst[i] = i % 7 == 0 ? 0 : random.generate();
+    }
+
+    QString error;
+    if (!matchesFormula(path, src, dst, error))
+        QFAIL(qPrintable(error));
+}
+
+void TestBlend::solidSpan()
+{
+    QRandomGenerator random(3505);
+    for (int run = 0; run < 10000; run++)
+    {
+        QRgb color = random.generate();
+        std::vector<QRgb> dst(1 + random.bounded(40));
+        for (QRgb &pixel : dst)
+            pixel = random.bounded(4) == 0 ? 0 : random.generate();
+
+        std::vector<QRgb> blended = dst;
+        Blend::solidSpan(blended.data(), color, int(blended.size()));
+        for (size_t i = 0; i < dst.size(); i++)
+            QCOMPARE(blended[i], originalBlend(color, dst[i]));
+    }
+}
+
+QTEST_APPLESS_MAIN(TestBlend)
+
+#include "tst_blend.moc"
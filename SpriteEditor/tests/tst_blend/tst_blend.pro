@@ -0,0 +1,16 @@
+QT += testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+TARGET = tst_blend
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../blend.cpp \
+    tst_blend.cpp
+
+HEADERS += \
+    ../../blend.h
@@ -0,0 +1,401 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Writes and reads back random animations in the binary project format, with and without colliding frame
+ * hashes, and checks that truncated and damaged files are rejected.
+ */
+
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include <QtTest>
+#include <iterator>
+#include <vector>
+#include "projectfile.h"
+
+Q_DECLARE_METATYPE(ProjectFile::Compression)
+
+namespace
+{
+    /**
+     * The ways the damaged test breaks a file
+     */
+    enum class Damage
+    {
+        UNKNOWN_COMPRESSION,
+        REFERENCE_TO_ITSELF,
+        RAW_PAYLOAD_SHORT,
+        RUN_PAST_FRAME_END,
+        PAYLOAD_PAST_FILE_END,
+        NOT_SQUARE,
+        NO_FRAMES
+    };
+
+    /**
+     * Where one frame chunk of a file is and what it holds
+     */
+    struct Chunk
+    {
+        qsizetype offset;
+        ProjectFile::Compression compression;
+        quint32 payloadSize;
+    };
+
+    /**
+     * Every frame hashes the same, so each frame looks like a repeat of every earlier one until its pixels are
+     * compared
+     */
+    quint64 collidingHash(const QRgb *, qsizetype)
+    {
+        return 0;
+    }
+
+    /**
+     * A sprite-like frame: colored blocks on a transparent background, some of them half transparent
+     */
+    QImage makeBlocks(QRandomGenerator &random, int size)
+    {
+        QImage frame(size, size, QImage::Format_ARGB32);
+        frame.fill(0);
+        int blocks = random.bounded(1, 8);
+        for (int block = 0; block < blocks; block++)
+        {
+            int left = random.bounded(size);
+            int top = random.bounded(size);
+            int width = random.bounded(1, size - left + 1);
+            int height = random.bounded(1, size - top + 1);
+            QRgb color = qRgba(random.bounded(256), random.bounded(256), random.bounded(256),
+                               random.bounded(2) ? 255 : 128);
+            for (int y = top; y < top + height; y++)
+            {
+                for (int x = left; x < left + width; x++)
+                    frame.setPixel(x, y, color);
+            }
+        }
+        return frame;
+    }
+
+    /**
+     * Random pixels, which run-length encoding only makes larger
+     */
+    QImage makeNoise(QRandomGenerator &random, int size)
+    {
+        QImage frame(size, size, QImage::Format_ARGB32);
+        for (int y = 0; y < size; y++)
+        {
+            for (int x = 0; x < size; x++)
+                frame.setPixel(x, y, random.generate());
+        }
+        return frame;
+    }
+
+    /**
+     * A random animation mixing block, noise and blank frames with frames that repeat the one before or an earlier
+     * one. Repeats are copies, so the writer has to find them by their pixels
+     */
+    std::vector<QImage> makeAnimation(QRandomGenerator &random, int size, int count)
+    {
+        std::vector<QImage> frames;
+        for (int i = 0; i < count; i++)
+        {
+            int kind = random.bounded(5);
+            if (kind == 0 && !frames.empty())
+            {
+                frames.push_back(frames.back().copy());
+            }
+            else if (kind == 1 && !frames.empty())
+            {
+                frames.push_back(frames[random.bounded(quint32(frames.size()))].copy());
+            }
+            else if (kind == 2)
+            {
+                frames.push_back(makeNoise(random, size));
+            }
+            else if (kind == 3)
+            {
+                QImage blank(size, size, QImage::Format_ARGB32);
+                blank.fill(0);
+                frames.push_back(blank);
+            }
+            else
+            {
+                frames.push_back(makeBlocks(random, size));
+            }
+        }
+        return frames;
+    }
+
+    /**
+     * Finds the frame chunks of a file by walking their headers
+     */
+    std::vector<Chunk> findChunks(const QByteArray &bytes)
+    {
+        const uchar *data = reinterpret_cast<const uchar *>(bytes.constData());
+        qsizetype offset = qFromLittleEndian<quint16>(data + 6);
+        quint32 frameCount = qFromLittleEndian<quint32>(data + 16);
+        std::vector<Chunk> chunks;
+        for (quint32 i = 0; i < frameCount; i++)
+        {
+            Chunk chunk{offset, ProjectFile::Compression(data[offset]), qFromLittleEndian<quint32>(data + offset + 4)};
+            chunks.push_back(chunk);
+            offset += 8 + chunk.payloadSize;
+        }
+        return chunks;
+    }
+
+    /**
+     * The frame a REFERENCE chunk names
+     */
+    quint32 referenceOf(const QByteArray &bytes, const Chunk &chunk)
+    {
+        return qFromLittleEndian<quint32>(bytes.constData() + chunk.offset + 8);
+    }
+
+    /**
+     * Saves frames in the binary format and returns the file's bytes, empty if saving failed
+     */
+    QByteArray writeFrames(const QString &filePath, const std::vector<QImage> &frames,
+                           ProjectFile::Compression compression, QString &error)
+    {
+        auto frameAt = [&frames](qsizetype index)
+        { return frames[size_t(index)]; };
+        if (!ProjectFile::write(filePath, qsizetype(frames.size()), frameAt, compression, error))
+            return QByteArray();
+        QFile file(filePath);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    /**
+     * Writes bytes to a file and reads it as a project
+     */
+    bool readBytes(const QString &filePath, const QByteArray &bytes, std::vector<QImage> &frames, int &size,
+                   QString &error)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size())
+            return false;
+        file.close();
+        return ProjectFile::read(filePath, frames, size, error);
+    }
+}
+
+Q_DECLARE_METATYPE(Damage)
+
+class TestProjectFile : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    /**
+     * Puts the real hash back after a test that forced collisions
+     */
+    void cleanup();
+
+    void roundTrip_data();
+
+    /**
+     * Random animations read back pixel for pixel. With run-length encoding every repeated frame is stored as a
+     * reference, unless colliding hashes hide the earlier copy, and no frame refers to one with other pixels
+     */
+    void roundTrip();
+
+    /**
+     * A file cut short anywhere is rejected and leaves the output alone
+     */
+    void truncated();
+
+    void damaged_data();
+
+    /**
+     * A file with a damaged header or chunk is rejected and leaves the output alone
+     */
+    void damaged();
+
+private:
+    quint64 (*realHash)(const QRgb *, qsizetype) = nullptr;
+};
+
+void TestProjectFile::initTestCase()
+{
+    realHash = ProjectFile::hashPixels;
+}
+
+void TestProjectFile::cleanup()
+{
+    ProjectFile::hashPixels = realHash;
+}
+
+void TestProjectFile::roundTrip_data()
+{
+    QTest::addColumn<ProjectFile::Compression>("compression");
+    QTest::addColumn<bool>("colliding");
+    QTest::addColumn<quint32>("seed");
+    const std::pair<const char *, ProjectFile::Compression> compressions[] = {
+        {"none", ProjectFile::Compression::NONE}, {"rle", ProjectFile::Compression::RLE}};
+    for (const auto &[name, compression] : compressions)
+    {
+        for (bool colliding : {false, true})
+        {
+            for (quint32 seed = 1; seed <= 20; seed++)
+            {
+                QTest::addRow("%s%s seed %u", name, colliding ? " colliding" : "", seed)
+                    << compression << colliding << seed;
+            }
+        }
+    }
+}
+
+void TestProjectFile::roundTrip()
+{
+    QFETCH(ProjectFile::Compression, compression);
+    QFETCH(bool, colliding);
+    QFETCH(quint32, seed);
+    if (colliding)
+        ProjectFile::hashPixels = collidingHash;
+
+    // Sizes with and without partial rows of SIMD blocks, up to long literal and repeated runs
+    const int sizes[] = {1, 3, 16, 33, 64, 200};
+    QRandomGenerator random(seed);
+    int size = sizes[random.bounded(int(std::size(sizes)))];
+    std::vector<QImage> frames = makeAnimation(random, size, random.bounded(1, 13));
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString filePath = directory.filePath("animation.ssp");
+    QString error;
+    QByteArray bytes = writeFrames(filePath, frames, compression, error);
+    QVERIFY2(!bytes.isEmpty(), qPrintable(error));
+
+    std::vector<QImage> loaded;
+    int loadedSize = 0;
+    QVERIFY2(ProjectFile::read(filePath, loaded, loadedSize, error), qPrintable(error));
+    QCOMPARE(loadedSize, size);
+    QCOMPARE(loaded.size(), frames.size());
+    for (size_t i = 0; i < frames.size(); i++)
+        QCOMPARE(loaded[i], frames[i]);
+
+    std::vector<Chunk> chunks = findChunks(bytes);
+    QCOMPARE(chunks.size(), frames.size());
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        bool repeated = false;
+        for (size_t earlier = 0; earlier < i; earlier++)
+            repeated = repeated || frames[earlier] == frames[i];
+
+        if (compression == ProjectFile::Compression::NONE)
+        {
+            QCOMPARE(chunks[i].compression, ProjectFile::Compression::NONE);
+        }
+        else if (chunks[i].compression == ProjectFile::Compression::REFERENCE)
+        {
+            quint32 reference = referenceOf(bytes, chunks[i]);
+            QVERIFY(reference < i);
+            QCOMPARE(frames[reference], frames[i]);
+        }
+        else
+        {
+            // Colliding hashes only let the writer compare with the frame before and the first frame
+            bool findable = !colliding || frames[i - (i > 0)] == frames[i] || frames[0] == frames[i];
+            QVERIFY2(!(repeated && findable), qPrintable(QString("frame %1 repeats an earlier one").arg(i)));
+        }
+    }
+}
+
+void TestProjectFile::truncated()
+{
+    QRandomGenerator random(3505);
+    std::vector<QImage> frames = {makeBlocks(random, 16), makeNoise(random, 16)};
+    frames.push_back(frames[0].copy());
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString error;
+    QByteArray bytes = writeFrames(directory.filePath("animation.ssp"), frames, ProjectFile::Compression::RLE, error);
+    QVERIFY2(!bytes.isEmpty(), qPrintable(error));
+
+    for (qsizetype length = 0; length < bytes.size(); length++)
+    {
+        std::vector<QImage> loaded = {QImage()};
+        int size = -1;
+        error.clear();
+        QVERIFY2(!readBytes(directory.filePath("truncated.ssp"), bytes.left(length), loaded, size, error),
+                 qPrintable(QString("read %1 of %2 bytes").arg(length).arg(bytes.size())));
+        QVERIFY(!error.isEmpty());
+        QCOMPARE(loaded.size(), size_t(1));
+        QCOMPARE(size, -1);
+    }
+}
+
+void TestProjectFile::damaged_data()
+{
+    QTest::addColumn<Damage>("damage");
+    QTest::newRow("unknown compression") << Damage::UNKNOWN_COMPRESSION;
+    QTest::newRow("reference to itself") << Damage::REFERENCE_TO_ITSELF;
+    QTest::newRow("raw payload short") << Damage::RAW_PAYLOAD_SHORT;
+    QTest::newRow("run past frame end") << Damage::RUN_PAST_FRAME_END;
+    QTest::newRow("payload past file end") << Damage::PAYLOAD_PAST_FILE_END;
+    QTest::newRow("not square") << Damage::NOT_SQUARE;
+    QTest::newRow("no frames") << Damage::NO_FRAMES;
+}
+
+void TestProjectFile::damaged()
+{
+    QFETCH(Damage, damage);
+
+    // One chunk of each kind: blocks compress, noise does not, and a repeat is a reference
+    QRandomGenerator random(3505);
+    std::vector<QImage> frames = {makeBlocks(random, 16), makeNoise(random, 16)};
+    frames.push_back(frames[0].copy());
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString error;
+    QByteArray bytes = writeFrames(directory.filePath("animation.ssp"), frames, ProjectFile::Compression::RLE, error);
+    QVERIFY2(!bytes.isEmpty(), qPrintable(error));
+    std::vector<Chunk> chunks = findChunks(bytes);
+    QCOMPARE(chunks[0].compression, ProjectFile::Compression::RLE);
+    QCOMPARE(chunks[1].compression, ProjectFile::Compression::NONE);
+    QCOMPARE(chunks[2].compression, ProjectFile::Compression::REFERENCE);
+
+    uchar *data = reinterpret_cast<uchar *>(bytes.data());
+    switch (damage)
+    {
+    case Damage::UNKNOWN_COMPRESSION:
+        data[chunks[0].offset] = 9;
+        break;
+    case Damage::REFERENCE_TO_ITSELF:
+        qToLittleEndian<quint32>(2, data + chunks[2].offset + 8);
+        break;
+    case Damage::RAW_PAYLOAD_SHORT:
+        qToLittleEndian<quint32>(chunks[1].payloadSize - 4, data + chunks[1].offset + 4);
+        break;
+    case Damage::RUN_PAST_FRAME_END:
+        // The longest run token repeats more pixels than a 16x16 frame holds
+        qToLittleEndian<quint16>(0xFFFF, data + chunks[0].offset + 8);
+        break;
+    case Damage::PAYLOAD_PAST_FILE_END:
+        qToLittleEndian<quint32>(chunks[2].payloadSize + 1, data + chunks[2].offset + 4);
+        break;
+    case Damage::NOT_SQUARE:
+        qToLittleEndian<quint32>(17, data + 12);
+        break;
+    case Damage::NO_FRAMES:
+        qToLittleEndian<quint32>(0, data + 16);
+        break;
+    }
+
+    std::vector<QImage> loaded = {QImage()};
+    int size = -1;
+    QVERIFY(!readBytes(directory.filePath("damaged.ssp"), bytes, loaded, size, error));
+    QVERIFY(!error.isEmpty());
+    QCOMPARE(loaded.size(), size_t(1));
+    QCOMPARE(size, -1);
+}
+
+QTEST_APPLESS_MAIN(TestProjectFile)
+
+#include "tst_projectfile.moc"
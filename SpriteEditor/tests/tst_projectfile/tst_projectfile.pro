@@ -0,0 +1,18 @@
+QT += testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+TARGET = tst_projectfile
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../projectfile.cpp \
+    tst_projectfile.cpp
+
+HEADERS += \
+    ../../contenthash.h \
+    ../../pixelview.h \
+    ../../projectfile.h
@@ -0,0 +1,83 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the background thumbnail maker.
+ */
+
+#include "thumbnailservice.h"
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace
+{
+    // Memory the cached thumbnails may take, in kilobytes
+    const qsizetype CACHE_KILOBYTES = 64 * 1024;
+}
+
+ThumbnailService::ThumbnailService(int size, QObject *parent) : QObject(parent), size(size)
+{
+    cache.setMaxCost(CACHE_KILOBYTES);
+}
+
+ThumbnailService::~ThumbnailService()
+{
+    pool.waitForDone();
+}
+
+bool ThumbnailService::find(quint32 id, quint64 generation, QPixmap &thumbnail)
+{
+    Entry *entry = cache.object(id);
+    if (!entry)
+        return false;
+    thumbnail = entry->pixmap;
+    return entry->generation >= generation;
+}
+
+void ThumbnailService::request(quint32 id, quint64 generation, TiledFrame frame)
+{
+    if (running.count(id))
+        return;
+    running.emplace(id, generation);
+
+    // Pixmaps can only be made on the GUI thread, the worker hands back a scaled image
+    int side = size;
+    QtConcurrent::run(&pool, [frame = std::move(frame), side]()
+                      { return scale(frame, side); })
+        .then(this, [this, id, generation, started = epoch](const QImage &image)
+              {
+                  if (started != epoch)
+                      return;
+                  running.erase(id);
+                  store(id, generation, QPixmap::fromImage(image));
+                  emit thumbnailReady(id);
+              });
+}
+
+QPixmap ThumbnailService::make(quint32 id, quint64 generation, const TiledFrame &frame)
+{
+    QPixmap pixmap = QPixmap::fromImage(scale(frame, size));
+    store(id, generation, pixmap);
+    return pixmap;
+}
+
+QImage ThumbnailService::scale(const TiledFrame &frame, int side)
+{
+    return frame.toImage().scaled(side, side, Qt::KeepAspectRatio, Qt::FastTransformation);
+}
+
+void ThumbnailService::store(quint32 id, quint64 generation, const QPixmap &pixmap)
+{
+    // A thumbnail made in the background may finish after a later one was made on the spot
+    Entry *entry = cache.object(id);
+    if (entry && entry->generation > generation)
+        return;
+    qsizetype cost = qsizetype(pixmap.width()) * pixmap.height() * 4 / 1024 + 1;
+    cache.insert(id, new Entry{generation, pixmap}, cost);
+}
+
+void ThumbnailService::clear()
+{
+    epoch++;
+    cache.clear();
+    running.clear();
+}
@@ -0,0 +1,123 @@
+#ifndef THUMBNAILSERVICE_H
+#define THUMBNAILSERVICE_H
+
+#include <QCache>
+#include <QObject>
+#include <QPixmap>
+#include <QThreadPool>
+#include <unordered_map>
+#include "tiledframe.h"
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Makes frame thumbnails on worker threads. Thumbnails are cached by frame id together with the edit
+ * generation they were made from, so a frame that moved keeps its thumbnail and one that was edited gets a new one.
+ * Until the new one is ready the old one is handed out, so only make waits for a thumbnail to be made.
+ * At most one thumbnail per frame is made in the background at a time
+ */
+class ThumbnailService : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief ThumbnailService - creates an empty cache
+     * @param size - width and height thumbnails are scaled to fit
+     * @param parent - owner of the service
+     */
+    explicit ThumbnailService(int size, QObject *parent = nullptr);
+
+    /**
+     * Waits for the thumbnails being made, they only touch their own frame copies
+     */
+    ~ThumbnailService();
+
+    /**
+     * @brief find - looks up the cached thumbnail of a frame
+     * @param id - the frame's id
+     * @param generation - the frame's edit generation
+     * @param thumbnail - set to the newest cached thumbnail of the frame, left alone if there is none
+     * @return true if the thumbnail is of the given generation or a later one
+     */
+    bool find(quint32 id, quint64 generation, QPixmap &thumbnail);
+
+    /**
+     * @brief request - starts making a thumbnail in the background, thumbnailReady is emitted when it is cached
+     * Nothing is started while the frame already has a thumbnail being made, asking again once that one is ready
+     * picks up the later generation
+     * @param id - the frame's id
+     * @param generation - the frame's edit generation
+     * @param frame - a copy of the frame, sharing its tiles so later edits do not affect it
+     */
+    void request(quint32 id, quint64 generation, TiledFrame frame);
+
+    /**
+     * @brief make - makes and caches a thumbnail on the calling thread, for callers that cannot show another frame's
+     * thumbnail in the meantime
+     * @param id - the frame's id
+     * @param generation - the frame's edit generation
+     * @param frame - the frame
+     * @return the thumbnail
+     */
+    QPixmap make(quint32 id, quint64 generation, const TiledFrame &frame);
+
+    /**
+     * @brief clear - drops every thumbnail, used when the frames were replaced by new ones
+     * Thumbnails still being made are thrown away when they finish
+     */
+    void clear();
+
+signals:
+    /**
+     * Emitted when a thumbnail was made and cached.
+     * @param id The id of the frame the thumbnail shows.
+     */
+    void thumbnailReady(quint32 id);
+
+private:
+    /**
+     * @brief A cached thumbnail
+     */
+    struct Entry
+    {
+        quint64 generation;
+        QPixmap pixmap;
+    };
+
+    int size;
+
+    /**
+     * @brief scale - turns a frame into a thumbnail image, safe to call on any thread
+     */
+    static QImage scale(const TiledFrame &frame, int side);
+
+    /**
+     * @brief store - caches a thumbnail unless a later generation of the frame is cached already
+     */
+    void store(quint32 id, quint64 generation, const QPixmap &pixmap);
+
+    /**
+     * @brief cache - thumbnails by frame id, costs are in kilobytes so the least recently used ones are dropped
+     * once they take too much memory
+     */
+    QCache<quint32, Entry> cache;
+
+    /**
+     * @brief running - generations being made by frame id
+     */
+    std::unordered_map<quint32, quint64> running;
+
+    /**
+     * @brief epoch - counts clear calls, thumbnails started before the last one are not cached
+     */
+    quint64 epoch = 0;
+
+    /**
+     * @brief pool - threads thumbnails are made on, kept apart from the pool saves and prefetching use
+     */
+    QThreadPool pool;
+};
+
+#endif // THUMBNAILSERVICE_H
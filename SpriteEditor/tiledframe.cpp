@@ -0,0 +1,326 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of tiled copy-on-write frames.
+ */
+
+#include "tiledframe.h"
+#include "contenthash.h"
+#include "pixelview.h"
+#include "projectfile.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+double TiledFrame::Usage::sharingRatio() const
+{
+    return uniqueTiles > 0 ? double(tileReferences) / double(uniqueTiles) : 1.0;
+}
+
+TiledFrame::TiledFrame(int size)
+    : frameSize(size), tilesPerRow((size + TILE_SIZE - 1) / TILE_SIZE), tiles(size_t(tilesPerRow) * tilesPerRow)
+{
+    rehash();
+}
+
+TiledFrame::TiledFrame(const QImage &image) : TiledFrame(image.width())
+{
+    Q_ASSERT(image.width() == image.height());
+    store(image, image.rect());
+}
+
+int TiledFrame::size() const
+{
+    return frameSize;
+}
+
+bool TiledFrame::readTile(const QImage &image, int tileX, int tileY, Tile &tile)
+{
+    ConstPixelView pixels(image);
+    int left = tileX * TILE_SIZE;
+    int top = tileY * TILE_SIZE;
+    int width = std::min(TILE_SIZE, pixels.width() - left);
+    int height = std::min(TILE_SIZE, pixels.height() - top);
+
+    // Edge tiles hang over the image, their outside part stays transparent
+    if (width < TILE_SIZE || height < TILE_SIZE)
+        std::memset(tile.pixels, 0, sizeof(tile.pixels));
+
+    QRgb used = 0;
+    for (int y = 0; y < height; y++)
+    {
+        const QRgb *row = pixels.row(top + y) + left;
+        QRgb *out = tile.pixels + y * TILE_SIZE;
+        for (int x = 0; x < width; x++)
+        {
+            out[x] = row[x];
+            used |= row[x];
+        }
+    }
+    return used != 0;
+}
+
+void TiledFrame::store(const QImage &image, const QRect &changed)
+{
+    Q_ASSERT(image.width() == frameSize && image.height() == frameSize);
+    QRect area = changed & image.rect();
+    if (area.isEmpty())
+        return;
+    unpack();
+
+    Tile tile;
+    for (int tileY = area.top() / TILE_SIZE; tileY <= area.bottom() / TILE_SIZE; tileY++)
+    {
+        for (int tileX = area.left() / TILE_SIZE; tileX <= area.right() / TILE_SIZE; tileX++)
+        {
+            std::shared_ptr<const Tile> &stored = tiles[size_t(tileY) * tilesPerRow + tileX];
+            if (!readTile(image, tileX, tileY, tile))
+            {
+                stored.reset();
+                continue;
+            }
+
+            // Keep sharing a tile whose pixels came back unchanged, otherwise this frame gets its own copy
+            tile.hash = ContentHash::pixels(tile.pixels, TILE_SIZE * TILE_SIZE);
+            if (sameTile(stored.get(), &tile))
+                continue;
+            stored = std::make_shared<const Tile>(tile);
+        }
+    }
+    rehash();
+}
+
+void TiledFrame::rehash()
+{
+    // Transparent tiles count as zero, the frame size is mixed in so blank frames of different sizes differ
+    quint64 hash = ContentHash::combine(0, quint64(frameSize));
+    for (const std::shared_ptr<const Tile> &tile : tiles)
+        hash = ContentHash::combine(hash, tile ? tile->hash : 0);
+    frameHash = hash;
+}
+
+qint64 TiledFrame::pack()
+{
+    if (isPacked())
+        return 0;
+
+    // Tiles other frames also use stay alive after packing, only the ones this frame alone holds are freed
+    qint64 freed = 0;
+    for (const std::shared_ptr<const Tile> &tile : tiles)
+    {
+        if (tile && tile.use_count() == 1)
+            freed += qint64(sizeof(Tile));
+    }
+    if (freed == 0)
+        return 0;
+
+    QImage image = toImage();
+    QByteArray runs;
+    ProjectFile::encodeRuns(ConstPixelView(image).row(0), qsizetype(frameSize) * frameSize, runs);
+    packed = std::make_shared<const QByteArray>(std::move(runs));
+    tiles.clear();
+    tiles.shrink_to_fit();
+    return freed - packed->size();
+}
+
+qint64 TiledFrame::pageOut(FramePager &pager)
+{
+    if (!packed)
+        return 0;
+
+    // A block copies of this frame still hold stays in memory anyway, so it is only paged out with the last copy
+    qint64 freed = packed.use_count() == 1 ? packed->size() : 0;
+    if (freed == 0)
+        return 0;
+    paged = pager.store(*packed);
+    if (!paged)
+        return 0;
+    packed.reset();
+    return freed;
+}
+
+void TiledFrame::unpack()
+{
+    if (!isPacked())
+        return;
+
+    // The hash does not change, store rehashes the same pixels
+    QImage image = toImage();
+    packed.reset();
+    paged.reset();
+    tiles.assign(size_t(tilesPerRow) * tilesPerRow, nullptr);
+    store(image, image.rect());
+}
+
+bool TiledFrame::isPacked() const
+{
+    return packed || paged;
+}
+
+bool TiledFrame::isPaged() const
+{
+    return paged != nullptr;
+}
+
+std::shared_ptr<const FramePager::Page> TiledFrame::page() const
+{
+    return paged;
+}
+
+quint64 TiledFrame::hash() const
+{
+    return frameHash;
+}
+
+bool TiledFrame::sameTile(const Tile *a, const Tile *b)
+{
+    if (a == b)
+        return true;
+    return a && b && a->hash == b->hash && std::memcmp(a->pixels, b->pixels, sizeof(a->pixels)) == 0;
+}
+
+bool TiledFrame::operator==(const TiledFrame &other) const
+{
+    if (frameSize != other.frameSize || frameHash != other.frameHash)
+        return false;
+    if (packed && other.packed)
+        return *packed == *other.packed;
+    if (isPacked() || other.isPacked())
+        return toImage() == other.toImage();
+    for (size_t i = 0; i < tiles.size(); i++)
+    {
+        if (!sameTile(tiles[i].get(), other.tiles[i].get()))
+            return false;
+    }
+    return true;
+}
+
+qsizetype TiledFrame::shareTiles(std::vector<TiledFrame> &frames)
+{
+    // Tiles seen so far by hash, a bucket holds more than one tile only when different pixels hash the same
+    std::unordered_map<quint64, std::vector<std::shared_ptr<const Tile>>> pool;
+    qsizetype merged = 0;
+    for (TiledFrame &frame : frames)
+    {
+        for (std::shared_ptr<const Tile> &tile : frame.tiles)
+        {
+            if (!tile)
+                continue;
+            std::vector<std::shared_ptr<const Tile>> &bucket = pool[tile->hash];
+            auto match = std::find_if(bucket.begin(), bucket.end(), [&tile](const std::shared_ptr<const Tile> &pooled)
+                                      { return sameTile(pooled.get(), tile.get()); });
+            if (match == bucket.end())
+            {
+                bucket.push_back(tile);
+            }
+            else if (*match != tile)
+            {
+                tile = *match;
+                merged++;
+            }
+        }
+    }
+    return merged;
+}
+
+std::vector<std::vector<size_t>> TiledFrame::findIdentical(const std::vector<TiledFrame> &frames)
+{
+    // Frames are grouped by hash first, then split by comparing pixels in case different frames hash the same
+    std::unordered_map<quint64, std::vector<std::vector<size_t>>> byHash;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        std::vector<std::vector<size_t>> &groups = byHash[frames[i].frameHash];
+        auto match = std::find_if(groups.begin(), groups.end(), [&](const std::vector<size_t> &group)
+                                  { return frames[group.front()] == frames[i]; });
+        if (match == groups.end())
+            groups.push_back({i});
+        else
+            match->push_back(i);
+    }
+
+    std::vector<std::vector<size_t>> identical;
+    for (auto &entry : byHash)
+    {
+        for (std::vector<size_t> &group : entry.second)
+        {
+            if (group.size() > 1)
+                identical.push_back(std::move(group));
+        }
+    }
+    std::sort(identical.begin(), identical.end());
+    return identical;
+}
+
+QImage TiledFrame::toImage() const
+{
+    QImage image(frameSize, frameSize, QImage::Format_ARGB32);
+    PixelView pixels(image);
+    if (isPacked())
+    {
+        // ARGB32 rows have no padding, so the whole frame decodes as one run of pixels
+        const uchar *runs = paged ? paged->data() : reinterpret_cast<const uchar *>(packed->constData());
+        qsizetype length = paged ? qsizetype(paged->size()) : packed->size();
+        bool decoded = ProjectFile::decodeRuns(runs, length, pixels.row(0), qsizetype(frameSize) * frameSize);
+        Q_ASSERT(decoded);
+        Q_UNUSED(decoded);
+        return image;
+    }
+    for (int tileY = 0; tileY < tilesPerRow; tileY++)
+    {
+        int top = tileY * TILE_SIZE;
+        int height = std::min(TILE_SIZE, frameSize - top);
+        for (int tileX = 0; tileX < tilesPerRow; tileX++)
+        {
+            int left = tileX * TILE_SIZE;
+            int width = std::min(TILE_SIZE, frameSize - left);
+            const Tile *tile = tiles[size_t(tileY) * tilesPerRow + tileX].get();
+            for (int y = 0; y < height; y++)
+            {
+                QRgb *row = pixels.row(top + y) + left;
+                if (tile)
+                    std::memcpy(row, tile->pixels + y * TILE_SIZE, size_t(width) * sizeof(QRgb));
+                else
+                    std::fill(row, row + width, 0u);
+            }
+        }
+    }
+    return image;
+}
+
+TiledFrame::Usage TiledFrame::usage(const std::vector<TiledFrame> &frames)
+{
+    Usage usage;
+    std::unordered_set<const Tile *> unique;
+    std::unordered_set<const QByteArray *> uniquePacked;
+    std::unordered_set<const FramePager::Page *> uniquePaged;
+    for (const TiledFrame &frame : frames)
+    {
+        usage.flatBytes += qint64(frame.frameSize) * frame.frameSize * qint64(sizeof(QRgb));
+        if (frame.paged)
+        {
+            usage.pagedFrames++;
+            if (uniquePaged.insert(frame.paged.get()).second)
+                usage.pagedBytes += frame.paged->size();
+            continue;
+        }
+        if (frame.packed)
+        {
+            usage.packedFrames++;
+            if (uniquePacked.insert(frame.packed.get()).second)
+                usage.bytes += frame.packed->size();
+            continue;
+        }
+        for (const std::shared_ptr<const Tile> &tile : frame.tiles)
+        {
+            if (!tile)
+                continue;
+            usage.tileReferences++;
+            unique.insert(tile.get());
+        }
+    }
+    usage.uniqueTiles = qsizetype(unique.size());
+    usage.bytes += qint64(unique.size()) * qint64(sizeof(Tile));
+    return usage;
+}
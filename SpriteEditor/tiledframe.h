@@ -0,0 +1,192 @@
+#ifndef TILEDFRAME_H
+#define TILEDFRAME_H
+
+#include "framepager.h"
+#include <QByteArray>
+#include <QImage>
+#include <QRect>
+#include <memory>
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief A square frame stored as 32x32 tiles of ARGB32 pixels. Tiles never change once made and are reference
+ * counted, so copying a frame shares all of its tiles and storing an edit replaces only the tiles it touched. Fully
+ * transparent tiles are not stored at all. Frames of a long animation that mostly repeats share most of their memory.
+ * Every tile is hashed once when it is made, so a frame's content hash is kept up to date by rehashing only the
+ * tiles an edit replaced. A frame that is not in use can be packed into one run-length encoded block, and a packed
+ * frame can be paged out to a scratch file, either is decoded again when the frame is drawn or edited
+ */
+class TiledFrame
+{
+public:
+    static constexpr int TILE_SIZE = 32;
+
+    /**
+     * @brief How much memory a set of frames uses and how much of it they share
+     */
+    struct Usage
+    {
+        // Stored tiles referenced by the frames, counting a shared tile once per frame using it
+        qsizetype tileReferences = 0;
+        // Distinct stored tiles
+        qsizetype uniqueTiles = 0;
+        // Bytes held by the distinct tiles
+        qint64 bytes = 0;
+        // Bytes the frames would take as whole images
+        qint64 flatBytes = 0;
+        // Frames held packed, their encoded bytes are part of bytes
+        qsizetype packedFrames = 0;
+        // Frames paged out to the scratch file and the bytes they take there, not part of bytes
+        qsizetype pagedFrames = 0;
+        qint64 pagedBytes = 0;
+
+        /**
+         * @brief sharingRatio - how many frames use each stored tile on average, 1 when nothing is shared
+         */
+        double sharingRatio() const;
+    };
+
+    /**
+     * @brief TiledFrame - an empty frame of size 0
+     */
+    TiledFrame() = default;
+
+    /**
+     * @brief TiledFrame - a fully transparent frame
+     * @param size - the width and height of the frame
+     */
+    explicit TiledFrame(int size);
+
+    /**
+     * @brief TiledFrame - splits an image into tiles
+     * @param image - a square ARGB32 image
+     */
+    explicit TiledFrame(const QImage &image);
+
+    /**
+     * @brief size - the width and height of the frame
+     */
+    int size() const;
+
+    /**
+     * @brief toImage - assembles the tiles into a new image
+     * @return an ARGB32 image of the frame
+     */
+    QImage toImage() const;
+
+    /**
+     * @brief store - takes the pixels of an area of an image into the frame
+     * Tiles the area touches are replaced, unless their pixels did not change, other tiles stay shared. A packed
+     * frame is unpacked first
+     * @param image - an ARGB32 image the size of the frame
+     * @param changed - the area of the image that may differ from the frame
+     */
+    void store(const QImage &image, const QRect &changed);
+
+    /**
+     * @brief pack - replaces the tiles with one run-length encoded copy of the frame
+     * Nothing happens when the frame is already packed or holds no tile other frames do not share, since packing it
+     * would free nothing. Copies of a packed frame share the encoded block
+     * @return an estimate of the bytes freed, the tiles only this frame used minus the encoded size
+     */
+    qint64 pack();
+
+    /**
+     * @brief pageOut - moves a packed frame's encoded block to a scratch file, other frames are left as they are
+     * @param pager - the scratch file
+     * @return an estimate of the bytes freed, 0 if the block is still used by a copy of the frame or could not be
+     * written, in which case the frame stays packed in memory
+     */
+    qint64 pageOut(FramePager &pager);
+
+    /**
+     * @brief unpack - splits a packed or paged frame back into tiles, other frames are left as they are
+     */
+    void unpack();
+
+    /**
+     * @brief isPacked - checks whether the frame is held run-length encoded in memory or in a scratch file instead of
+     * as tiles
+     */
+    bool isPacked() const;
+
+    /**
+     * @brief isPaged - checks whether the frame is held in a scratch file
+     */
+    bool isPaged() const;
+
+    /**
+     * @brief page - the scratch file page holding the frame, null unless the frame is paged
+     */
+    std::shared_ptr<const FramePager::Page> page() const;
+
+    /**
+     * @brief hash - a hash of the frame's pixels, equal for frames with equal pixels whatever tiles they share
+     */
+    quint64 hash() const;
+
+    /**
+     * @brief operator== - checks whether two frames have exactly the same pixels
+     */
+    bool operator==(const TiledFrame &other) const;
+
+    /**
+     * @brief shareTiles - makes tiles with equal pixels in any of the frames one shared tile
+     * Identical frames end up sharing all of their tiles, packed frames are left out
+     * @param frames - the frames to deduplicate
+     * @return the number of tiles that were replaced by an equal shared tile
+     */
+    static qsizetype shareTiles(std::vector<TiledFrame> &frames);
+
+    /**
+     * @brief findIdentical - groups frames whose pixels are exactly the same
+     * @param frames - the frames to compare
+     * @return every group of two or more identical frames as ascending frame indices, ordered by their first frame
+     */
+    static std::vector<std::vector<size_t>> findIdentical(const std::vector<TiledFrame> &frames);
+
+    /**
+     * @brief usage - measures the memory used by a set of frames, counting tiles they share once
+     * @param frames - the frames to measure
+     */
+    static Usage usage(const std::vector<TiledFrame> &frames);
+
+private:
+    struct Tile
+    {
+        QRgb pixels[TILE_SIZE * TILE_SIZE];
+        // ContentHash of the pixels
+        quint64 hash;
+    };
+
+    /**
+     * @brief sameTile - checks whether two tiles, either of which may be null, hold the same pixels
+     */
+    static bool sameTile(const Tile *a, const Tile *b);
+
+    /**
+     * @brief rehash - recomputes the frame hash from the tile hashes
+     */
+    void rehash();
+
+    /**
+     * @brief readTile - copies one tile of an image, zero filling the part outside the image
+     * @return true if any copied pixel is not fully transparent black
+     */
+    static bool readTile(const QImage &image, int tileX, int tileY, Tile &tile);
+
+    int frameSize = 0;
+    int tilesPerRow = 0;
+    // Tiles in row order, null for fully transparent tiles, empty while the frame is packed
+    std::vector<std::shared_ptr<const Tile>> tiles;
+    // The pixels run-length encoded as in ProjectFile, set only while the frame is packed in memory
+    std::shared_ptr<const QByteArray> packed;
+    // The same encoding in a scratch file, set only while the frame is paged
+    std::shared_ptr<const FramePager::Page> paged;
+    quint64 frameHash = 0;
+};
+
+#endif // TILEDFRAME_H
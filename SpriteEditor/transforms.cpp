@@ -0,0 +1,253 @@
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Implementation of the frame transforms. Quarter turns are a transpose followed by a flip, so every
+ * operation reduces to row reversal, row swapping and a tiled transpose
+ */
+
+#include "transforms.h"
+#include "pixelview.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRANSFORMS_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    /**
+     * Side length of the square tiles the transpose works through, small enough that a pair of tiles stays in L1
+     */
+    constexpr int TILE_SIZE = 32;
+
+#ifdef TRANSFORMS_HAVE_SSE2
+    inline __m128i load4(const QRgb *pixels)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels));
+    }
+
+    inline void store4(QRgb *pixels, __m128i value)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels), value);
+    }
+
+    /**
+     * Reverses the order of four pixels
+     */
+    inline __m128i reverse4(__m128i value)
+    {
+        return _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+
+    /**
+     * Transposes a 4x4 block of pixels held in four registers
+     */
+    inline void transpose4x4(__m128i &row0, __m128i &row1, __m128i &row2, __m128i &row3)
+    {
+        __m128i low01 = _mm_unpacklo_epi32(row0, row1);
+        __m128i low23 = _mm_unpacklo_epi32(row2, row3);
+        __m128i high01 = _mm_unpackhi_epi32(row0, row1);
+        __m128i high23 = _mm_unpackhi_epi32(row2, row3);
+        row0 = _mm_unpacklo_epi64(low01, low23);
+        row1 = _mm_unpackhi_epi64(low01, low23);
+        row2 = _mm_unpacklo_epi64(high01, high23);
+        row3 = _mm_unpackhi_epi64(high01, high23);
+    }
+#endif
+
+    /**
+     * Reverses a run of pixels in place, four pixels from each end at a time
+     */
+    void reverseRun(QRgb *pixels, int count)
+    {
+        int left = 0, right = count;
+#ifdef TRANSFORMS_HAVE_SSE2
+        while (right - left >= 8)
+        {
+            __m128i fromLeft = load4(pixels + left);
+            __m128i fromRight = load4(pixels + right - 4);
+            store4(pixels + left, reverse4(fromRight));
+            store4(pixels + right - 4, reverse4(fromLeft));
+            left += 4;
+            right -= 4;
+        }
+#endif
+        std::reverse(pixels + left, pixels + right);
+    }
+
+    /**
+     * Swaps first[i] with second[count - 1 - i] for every i, the two runs must not overlap
+     */
+    void reverseSwapRuns(QRgb *first, QRgb *second, int count)
+    {
+        int i = 0;
+#ifdef TRANSFORMS_HAVE_SSE2
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i fromFirst = load4(first + i);
+            __m128i fromSecond = load4(second + count - 4 - i);
+            store4(first + i, reverse4(fromSecond));
+            store4(second + count - 4 - i, reverse4(fromFirst));
+        }
+#endif
+        for (; i < count; i++)
+            std::swap(first[i], second[count - 1 - i]);
+    }
+
+    /**
+     * Swaps the tile at rows [top, bottom) and columns [left, right) with its mirror across the diagonal.
+     * The tile must lie entirely above the diagonal
+     */
+    void swapTransposedTiles(const PixelView &pixels, int top, int bottom, int left, int right)
+    {
+        int y = top;
+#ifdef TRANSFORMS_HAVE_SSE2
+        for (; y + 4 <= bottom; y += 4)
+        {
+            int x = left;
+            for (; x + 4 <= right; x += 4)
+            {
+                // Load the block and its mirror, transpose both, then store each in the other's place
+                __m128i a0 = load4(pixels.row(y) + x), a1 = load4(pixels.row(y + 1) + x);
+                __m128i a2 = load4(pixels.row(y + 2) + x), a3 = load4(pixels.row(y + 3) + x);
+                __m128i b0 = load4(pixels.row(x) + y), b1 = load4(pixels.row(x + 1) + y);
+                __m128i b2 = load4(pixels.row(x + 2) + y), b3 = load4(pixels.row(x + 3) + y);
+                transpose4x4(a0, a1, a2, a3);
+                transpose4x4(b0, b1, b2, b3);
+                store4(pixels.row(y) + x, b0);
+                store4(pixels.row(y + 1) + x, b1);
+                store4(pixels.row(y + 2) + x, b2);
+                store4(pixels.row(y + 3) + x, b3);
+                store4(pixels.row(x) + y, a0);
+                store4(pixels.row(x + 1) + y, a1);
+                store4(pixels.row(x + 2) + y, a2);
+                store4(pixels.row(x + 3) + y, a3);
+            }
+            // Columns left over at the right edge of the tile
+            for (int row = y; row < y + 4; row++)
+            {
+                for (int column = x; column < right; column++)
+                    std::swap(pixels.at(column, row), pixels.at(row, column));
+            }
+        }
+#endif
+        // Rows left over at the bottom edge of the tile
+        for (; y < bottom; y++)
+        {
+            for (int x = left; x < right; x++)
+                std::swap(pixels.at(x, y), pixels.at(y, x));
+        }
+    }
+}
+
+void FrameTransform::apply(QImage &image, Operation operation)
+{
+    if (image.isNull())
+        return;
+
+    switch (operation)
+    {
+    case Operation::FLIP_HORIZONTAL:
+        flipHorizontal(image);
+        break;
+    case Operation::FLIP_VERTICAL:
+        flipVertical(image);
+        break;
+    case Operation::ROTATE_180:
+        rotate180(image);
+        break;
+    case Operation::TRANSPOSE:
+    case Operation::ROTATE_90:
+    case Operation::ROTATE_270:
+        if (image.width() == image.height())
+            transposeSquare(image);
+        else
+            image = transposeCopy(image);
+
+        // A quarter turn is a transpose followed by a flip
+        if (operation == Operation::ROTATE_90)
+            flipHorizontal(image);
+        else if (operation == Operation::ROTATE_270)
+            flipVertical(image);
+        break;
+    }
+}
+
+void FrameTransform::applyToAll(std::vector<QImage> &images, Operation operation)
+{
+    // Frames are independent, so each one can be transformed on its own thread
+    QtConcurrent::blockingMap(images, [operation](QImage &image)
+                              { apply(image, operation); });
+}
+
+void FrameTransform::flipHorizontal(QImage &image)
+{
+    PixelView pixels(image);
+    for (int y = 0; y < pixels.height(); y++)
+        reverseRun(pixels.row(y), pixels.width());
+}
+
+void FrameTransform::flipVertical(QImage &image)
+{
+    PixelView pixels(image);
+    for (int top = 0, bottom = pixels.height() - 1; top < bottom; top++, bottom--)
+        std::swap_ranges(pixels.row(top), pixels.row(top) + pixels.width(), pixels.row(bottom));
+}
+
+void FrameTransform::rotate180(QImage &image)
+{
+    PixelView pixels(image);
+    int top = 0, bottom = pixels.height() - 1;
+    for (; top < bottom; top++, bottom--)
+        reverseSwapRuns(pixels.row(top), pixels.row(bottom), pixels.width());
+
+    // An odd height leaves a middle row that only needs reversing
+    if (top == bottom)
+        reverseRun(pixels.row(top), pixels.width());
+}
+
+void FrameTransform::transposeSquare(QImage &image)
+{
+    PixelView pixels(image);
+    const int size = pixels.width();
+    for (int tileTop = 0; tileTop < size; tileTop += TILE_SIZE)
+    {
+        int tileBottom = std::min(tileTop + TILE_SIZE, size);
+
+        // Tiles on the diagonal are transposed within themselves
+        for (int y = tileTop; y < tileBottom; y++)
+        {
+            for (int x = y + 1; x < tileBottom; x++)
+                std::swap(pixels.at(x, y), pixels.at(y, x));
+        }
+
+        // Tiles above the diagonal trade places with their mirror below it
+        for (int tileLeft = tileBottom; tileLeft < size; tileLeft += TILE_SIZE)
+            swapTransposedTiles(pixels, tileTop, tileBottom, tileLeft, std::min(tileLeft + TILE_SIZE, size));
+    }
+}
+
+QImage FrameTransform::transposeCopy(const QImage &image)
+{
+    QImage result(image.height(), image.width(), image.format());
+    ConstPixelView source(image);
+    PixelView target(result);
+    for (int tileTop = 0; tileTop < source.height(); tileTop += TILE_SIZE)
+    {
+        int tileBottom = std::min(tileTop + TILE_SIZE, source.height());
+        for (int tileLeft = 0; tileLeft < source.width(); tileLeft += TILE_SIZE)
+        {
+            int tileRight = std::min(tileLeft + TILE_SIZE, source.width());
+            for (int y = tileTop; y < tileBottom; y++)
+            {
+                const QRgb *row = source.row(y);
+                for (int x = tileLeft; x < tileRight; x++)
+                    target.at(y, x) = row[x];
+            }
+        }
+    }
+    return result;
+}
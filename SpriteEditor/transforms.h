@@ -0,0 +1,80 @@
+#ifndef TRANSFORMS_H
+#define TRANSFORMS_H
+
+#include <QImage>
+#include <vector>
+
+/**
+ * University of Utah – CS 3505
+ * @authors Noah Zaffos, Ethan Perkins, Caleb Standfield, Jas Sandhu, Nash Hawkins, John Chen
+ * @date 10/18/2026
+ * @brief Geometric transforms for ARGB32 frames. Square frames are transformed in place by swapping pixels inside
+ * cache sized tiles, with SSE2 shuffles reversing and transposing four pixels at a time
+ */
+class FrameTransform
+{
+public:
+    /**
+     * @brief Operation - the transforms that can be applied to a frame
+     */
+    enum class Operation
+    {
+        // Mirror left to right
+        FLIP_HORIZONTAL,
+        // Mirror top to bottom
+        FLIP_VERTICAL,
+        // Rotate a quarter turn clockwise
+        ROTATE_90,
+        // Rotate a half turn
+        ROTATE_180,
+        // Rotate a quarter turn counter clockwise
+        ROTATE_270,
+        // Mirror across the top-left to bottom-right diagonal
+        TRANSPOSE
+    };
+
+    /**
+     * @brief apply - transforms one image
+     * Flips and half turns always work in place. Quarter turns and transposes work in place on square images and
+     * build a new image with swapped dimensions otherwise
+     * @param image - the ARGB32 image to transform
+     * @param operation - the transform to apply
+     */
+    static void apply(QImage &image, Operation operation);
+
+    /**
+     * @brief applyToAll - transforms every image in a list, spreading the frames across the thread pool
+     * @param images - the ARGB32 images to transform, none of which may share data with another
+     * @param operation - the transform to apply
+     */
+    static void applyToAll(std::vector<QImage> &images, Operation operation);
+
+private:
+    /**
+     * @brief flipHorizontal - reverses every row in place
+     */
+    static void flipHorizontal(QImage &image);
+
+    /**
+     * @brief flipVertical - swaps rows top to bottom in place
+     */
+    static void flipVertical(QImage &image);
+
+    /**
+     * @brief rotate180 - reverses the rows and their order in one pass
+     */
+    static void rotate180(QImage &image);
+
+    /**
+     * @brief transposeSquare - mirrors a square image across its diagonal in place, one tile pair at a time
+     */
+    static void transposeSquare(QImage &image);
+
+    /**
+     * @brief transposeCopy - builds a transposed copy of an image of any shape
+     * @return the transposed image
+     */
+    static QImage transposeCopy(const QImage &image);
+};
+
+#endif // TRANSFORMS_H